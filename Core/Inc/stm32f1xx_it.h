@@ -61,6 +61,8 @@ void TIM8_UP_IRQHandler(void);
 void TIM6_IRQHandler(void);
 void TIM7_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void TIM1_UP_IRQHandler(void);
+void ADC1_2_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,218 @@
+/**
+ * @file adc_sense.c
+ * @brief 电机电流与母线电压采样（ADC1 注入组 + 规则组DMA，寄存器级实现）
+ *
+ * 时序：
+ * 1. TIM1 主模式输出更新事件（TRGO），注入组在每个PWM周期同一相位启动 4 路电流转换。
+ *    初始化时 TIM1 切换为中心对齐（频率不变），更新事件只在计数器下溢，即导通脉冲中点；
+ *    4 路依次转换，第 k 路（0~3）在中点后约 k × 1.7µs 采样。
+ *    边沿对齐时更新事件位于所有通道的导通边沿（开关振铃），后几路在低占空比时
+ *    已落在关断期（低边采样读数约为0），此时电流环拒绝开启，见 adc_sense.h
+ * 2. 注入转换会打断规则组，结束后规则组自动继续
+ * 3. 规则组连续扫描母线电压与内部参考电压，DMA 循环写入 vbus_buf
+ */
+
+#include "adc_sense.h"
+#include "main.h"
+#include "../motor/ax_motor.h"
+
+#define ADC_FULL_SCALE   4095u
+
+/* 采样时间编码（SMPx） */
+#define SMP_7_5          2u     ///< 7.5 周期：电流（放大器输出低阻），每路 20 周期 ≈ 1.7µs @12MHz
+#define SMP_239_5        7u     ///< 239.5 周期：母线电压/内部参考（需 ≥17µs）
+
+/* 通道号 */
+#define CH_CUR_A         4u
+#define CH_CUR_B         5u
+#define CH_CUR_C         8u
+#define CH_CUR_D         9u
+#define CH_VBUS          14u
+#define CH_VREFINT       17u
+
+#define VBUS_CHANNELS    2u     ///< 规则组：母线电压、内部参考
+static volatile uint16_t vbus_buf[ADC_SENSE_VBUS_DEPTH * VBUS_CHANNELS];  ///< DMA 循环缓冲
+
+/* 私有函数声明 */
+static void AdcSense_GpioInit(void);
+static void AdcSense_Calibrate(void);
+static void AdcSense_MeasureOffsets(void);
+static uint32_t AdcSense_BufAverage(uint32_t slot);
+
+/**
+ * @brief 初始化ADC采样
+ */
+void AdcSense_Init(void) {
+    AdcSense_GpioInit();
+
+    // 1. 时钟：ADCCLK = PCLK2 / 6 = 12MHz（上限14MHz）
+    MODIFY_REG(RCC->CFGR, RCC_CFGR_ADCPRE, RCC_CFGR_ADCPRE_DIV6);
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    // 2. 上电并校准
+    ADC1->CR1 = ADC_CR1_SCAN;
+    ADC1->CR2 = ADC_CR2_ADON;
+    HAL_Delay(1);  // tSTAB
+    AdcSense_Calibrate();
+
+    // 3. 采样时间与转换序列
+    ADC1->SMPR2 = (SMP_7_5 << (3u * CH_CUR_A)) | (SMP_7_5 << (3u * CH_CUR_B)) |
+                  (SMP_7_5 << (3u * CH_CUR_C)) | (SMP_7_5 << (3u * CH_CUR_D));
+    ADC1->SMPR1 = (SMP_239_5 << (3u * (CH_VBUS - 10u))) |
+                  (SMP_239_5 << (3u * (CH_VREFINT - 10u)));
+    ADC1->JSQR = (3u << ADC_JSQR_JL_Pos) |
+                 (CH_CUR_A << ADC_JSQR_JSQ1_Pos) | (CH_CUR_B << ADC_JSQR_JSQ2_Pos) |
+                 (CH_CUR_C << ADC_JSQR_JSQ3_Pos) | (CH_CUR_D << ADC_JSQR_JSQ4_Pos);
+    ADC1->SQR1 = (VBUS_CHANNELS - 1u) << ADC_SQR1_L_Pos;
+    ADC1->SQR3 = (CH_VBUS << ADC_SQR3_SQ1_Pos) | (CH_VREFINT << ADC_SQR3_SQ2_Pos);
+
+    // 4. 电流零点（电机静止，软件触发注入组）
+    AdcSense_MeasureOffsets();
+
+    // 5. 规则组：DMA1通道1 循环搬运，连续扫描
+    DMA1_Channel1->CCR = 0;
+    DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+    DMA1_Channel1->CMAR = (uint32_t)vbus_buf;
+    DMA1_Channel1->CNDTR = ADC_SENSE_VBUS_DEPTH * VBUS_CHANNELS;
+    DMA1_Channel1->CCR = DMA_CCR_MINC | DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 |
+                         DMA_CCR_CIRC | DMA_CCR_EN;
+
+    // 6. TIM1 改为中心对齐（更新事件在导通脉冲中点），注入组改由 TIM1_TRGO 触发
+    //    （JEXTSEL = 000），TIM1 主模式输出更新事件
+    if (!Motor_IsCenterAligned()) {
+        Motor_SetPwmConfig(Motor_GetPwmFreq(), true);
+    }
+    MODIFY_REG(TIM1->CR2, TIM_CR2_MMS, TIM_CR2_MMS_1);
+    ADC1->CR2 = ADC_CR2_ADON | ADC_CR2_TSVREFE |
+                ADC_CR2_JEXTTRIG |
+                ADC_CR2_EXTTRIG | ADC_CR2_EXTSEL |   // 规则组：SWSTART
+                ADC_CR2_CONT | ADC_CR2_DMA;
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+
+    // 7. 注入转换完成中断（电流环），最高优先级，由 AdcSense_EnableIrq() 开关
+    HAL_NVIC_SetPriority(ADC1_2_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(ADC1_2_IRQn);
+}
+
+void AdcSense_EnableIrq(bool enable) {
+    if (enable) {
+        ADC1->SR = ~ADC_SR_JEOC;
+        ADC1->CR1 |= ADC_CR1_JEOCIE;
+    } else {
+        ADC1->CR1 &= ~ADC_CR1_JEOCIE;
+    }
+}
+
+/**
+ * @brief 电流（mA）换算为ADC计数（与 AdcSense_GetCurrentRaw 同单位）
+ */
+int32_t AdcSense_CurrentToRaw(int32_t ma) {
+    return (int32_t)(((int64_t)ma * ADC_SENSE_AMP_GAIN * ADC_SENSE_SHUNT_MOHM * ADC_FULL_SCALE) /
+                     (1000 * (int64_t)AdcSense_GetVdda()));
+}
+
+/**
+ * @brief 电机电流（mA）
+ * @note I = ΔV / (增益 · R)，ΔV = raw · VDDA / 4095
+ */
+int32_t AdcSense_GetCurrent(MotorID id) {
+    int32_t mv = ((int32_t)AdcSense_GetCurrentRaw(id) * (int32_t)AdcSense_GetVdda()) /
+                 (int32_t)ADC_FULL_SCALE;
+    return (mv * 1000) / (ADC_SENSE_AMP_GAIN * ADC_SENSE_SHUNT_MOHM);
+}
+
+/**
+ * @brief 去偏后的原始电流采样（JDRx 已由硬件减去 JOFRx，带符号）
+ */
+int16_t AdcSense_GetCurrentRaw(MotorID id) {
+    switch (id) {
+        case MOTOR_A: return (int16_t)ADC1->JDR1;
+        case MOTOR_B: return (int16_t)ADC1->JDR2;
+        case MOTOR_C: return (int16_t)ADC1->JDR3;
+        case MOTOR_D: return (int16_t)ADC1->JDR4;
+        default:      return 0;
+    }
+}
+
+uint32_t AdcSense_GetVbus(void) {
+    return (AdcSense_BufAverage(0) * AdcSense_GetVdda() * ADC_SENSE_VBUS_DIV) / ADC_FULL_SCALE;
+}
+
+uint32_t AdcSense_GetVdda(void) {
+    uint32_t vref = AdcSense_BufAverage(1);
+
+    if (vref == 0u) {
+        return 3300u;  // DMA 尚未填充，返回标称值
+    }
+    return (ADC_SENSE_VREFINT_MV * ADC_FULL_SCALE) / vref;
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+static void AdcSense_GpioInit(void) {
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    GPIO_InitStruct.Pin = GPIO_PIN_4 | GPIO_PIN_5;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = GPIO_PIN_0 | GPIO_PIN_1;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = GPIO_PIN_4;
+    HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
+}
+
+/**
+ * @brief ADC 自校准（复位校准寄存器后启动校准）
+ */
+static void AdcSense_Calibrate(void) {
+    ADC1->CR2 |= ADC_CR2_RSTCAL;
+    while ((ADC1->CR2 & ADC_CR2_RSTCAL) != 0u) {
+    }
+    ADC1->CR2 |= ADC_CR2_CAL;
+    while ((ADC1->CR2 & ADC_CR2_CAL) != 0u) {
+    }
+}
+
+/**
+ * @brief 测量电流零点并写入注入通道偏置寄存器（仅初始化时轮询）
+ */
+static void AdcSense_MeasureOffsets(void) {
+    uint32_t sum[4] = { 0, 0, 0, 0 };
+
+    ADC1->JOFR1 = 0;
+    ADC1->JOFR2 = 0;
+    ADC1->JOFR3 = 0;
+    ADC1->JOFR4 = 0;
+    ADC1->CR2 |= ADC_CR2_JEXTTRIG | ADC_CR2_JEXTSEL;  // JEXTSEL = 111：JSWSTART
+
+    for (uint32_t n = 0; n < ADC_SENSE_OFFSET_SAMPLES; n++) {
+        ADC1->SR = ~ADC_SR_JEOC;
+        ADC1->CR2 |= ADC_CR2_JSWSTART;
+        while ((ADC1->SR & ADC_SR_JEOC) == 0u) {
+        }
+        sum[0] += ADC1->JDR1;
+        sum[1] += ADC1->JDR2;
+        sum[2] += ADC1->JDR3;
+        sum[3] += ADC1->JDR4;
+    }
+    ADC1->SR = ~ADC_SR_JEOC;
+
+    ADC1->JOFR1 = sum[0] / ADC_SENSE_OFFSET_SAMPLES;
+    ADC1->JOFR2 = sum[1] / ADC_SENSE_OFFSET_SAMPLES;
+    ADC1->JOFR3 = sum[2] / ADC_SENSE_OFFSET_SAMPLES;
+    ADC1->JOFR4 = sum[3] / ADC_SENSE_OFFSET_SAMPLES;
+}
+
+/**
+ * @brief DMA 缓冲区中某一通道的平均值
+ * @param slot 规则序列中的位置（0 = 母线电压，1 = 内部参考）
+ */
+static uint32_t AdcSense_BufAverage(uint32_t slot) {
+    uint32_t sum = 0;
+
+    for (uint32_t i = slot; i < ADC_SENSE_VBUS_DEPTH * VBUS_CHANNELS; i += VBUS_CHANNELS) {
+        sum += vbus_buf[i];
+    }
+    return sum / ADC_SENSE_VBUS_DEPTH;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file adc_sense.h
+ * @brief 电机电流与母线电压采样（ADC1，寄存器级驱动）
+ *
+ * @note 工程未包含 HAL ADC 驱动（stm32f1xx_hal_conf.h 中 ADC 模块关闭），本模块直接操作寄存器。
+ *       - 注入组：4路电流，TIM1_TRGO（更新事件）触发，与PWM同相位采样；
+ *         零点偏置写入 JOFRx，JDRx 直接为带符号的去偏结果。
+ *         初始化时把 TIM1 切换为中心对齐（频率不变），采样从导通脉冲中点开始，
+ *         各路相隔约 1.7µs；导通时间小于约 2 × (k+1) × 1.7µs 时第 k 路仍会落在关断期。
+ *         运行中切换为边沿对齐后采样点位于导通边沿，读数不可靠：电流环拒绝开启
+ *         （已开启时不允许切换），I²t 热模型、编码器断线检测与遥测电流只作参考
+ *       - 规则组：母线电压 + 内部参考电压，连续扫描，DMA1通道1循环搬运到缓冲区
+ *       两组均由硬件完成，读取接口只访问寄存器/缓冲区，无需CPU轮询。
+ *
+ *       引脚分配：
+ *         PA4 ADC_IN4  —— 电机A电流     PA5 ADC_IN5  —— 电机B电流
+ *         PB0 ADC_IN8  —— 电机C电流     PB1 ADC_IN9  —— 电机D电流
+ *         PC4 ADC_IN14 —— 母线电压分压
+ */
+
+#ifndef __ADC_SENSE_H
+#define __ADC_SENSE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 硬件参数（按实际电路修改） -------------------------------------------*/
+#define ADC_SENSE_SHUNT_MOHM     100    ///< 采样电阻（mΩ）
+#define ADC_SENSE_AMP_GAIN       10     ///< 电流放大倍数
+#define ADC_SENSE_VBUS_DIV       11     ///< 母线分压比（如 100k/10k → 11）
+#define ADC_SENSE_VREFINT_MV     1200   ///< 内部参考电压典型值（mV）
+#define ADC_SENSE_OFFSET_SAMPLES 64     ///< 上电零点标定采样次数
+#define ADC_SENSE_VBUS_DEPTH     8      ///< 母线电压DMA缓冲深度（每通道）
+
+/**
+ * @brief 初始化ADC1、DMA1通道1，标定电流零点并启动采样
+ * @note 须在 Motor_Init() 之后、PID_Init() 之前调用；标定时电机应静止
+ */
+void AdcSense_Init(void);
+
+/**
+ * @brief 最近一次PWM同步采样的电机电流
+ * @return 电流（mA，带符号，方向取决于采样电路）
+ */
+int32_t AdcSense_GetCurrent(MotorID id);
+
+/**
+ * @brief 最近一次电流采样的原始值（去偏后的ADC计数）
+ */
+int16_t AdcSense_GetCurrentRaw(MotorID id);
+
+/**
+ * @brief 电流（mA）换算为ADC计数
+ */
+int32_t AdcSense_CurrentToRaw(int32_t ma);
+
+/**
+ * @brief 开关注入转换完成中断（ADC1_2_IRQn，电流环使用）
+ * @note 中断服务中须清除 JEOC 标志
+ */
+void AdcSense_EnableIrq(bool enable);
+
+/**
+ * @brief 母线电压（DMA缓冲区平均）
+ * @return 电压（mV）
+ */
+uint32_t AdcSense_GetVbus(void);
+
+/**
+ * @brief 由内部参考电压反算的ADC参考电压 VDDA（mV）
+ */
+uint32_t AdcSense_GetVdda(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ADC_SENSE_H */
@@ -0,0 +1,186 @@
+/**
+ * @file autotune.c
+ * @brief 速度环继电器反馈自整定（全整型实现）
+ *
+ * 原理：
+ * 1. 以启动时的PWM输出 u0 为中心，按速度误差符号输出 u0 ± d（带回差 h）
+ * 2. 系统进入极限环，测量振荡周期 Tu 与速度峰峰值 2a
+ * 3. 临界增益 Ku = 4d / (π·sqrt(a² - h²))
+ * 4. 按所选规则由 Ku、Tu 计算离散PID参数（1ms周期，参数 ×100）
+ */
+
+#include "autotune.h"
+#include "../fixmath/fixmath.h"
+#include "../motor_cmd/motor_cmd.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
+
+/**
+ * @brief 整定规则系数（千分比）
+ * @note Kp = Ku·kp/1000，Ki = Ku·ki/(1000·Tu)，Kd = Ku·kd·Tu/1000
+ */
+typedef struct {
+    int32_t kp;
+    int32_t ki;
+    int32_t kd;
+} TuneRule;
+
+static const TuneRule tune_rules[AUTOTUNE_RULE_COUNT] = {
+    [AUTOTUNE_RULE_ZN_PI]        = { 450,  540,  0 },  // Kp=0.45Ku, Ti=Tu/1.2
+    [AUTOTUNE_RULE_ZN_PID]       = { 600, 1200, 75 },  // Kp=0.6Ku,  Ti=Tu/2,  Td=Tu/8
+    [AUTOTUNE_RULE_TL_PI]        = { 313,  142,  0 },  // Kp=Ku/3.2, Ti=2.2Tu
+    [AUTOTUNE_RULE_NO_OVERSHOOT] = { 200,  400, 67 },  // Kp=0.2Ku,  Ti=Tu/2,  Td=Tu/3
+};
+
+/**
+ * @brief 自整定运行状态
+ */
+typedef struct {
+    bool active;            ///< 是否正在整定
+    MotorID id;             ///< 被整定的电机
+    AutotuneRule rule;      ///< 整定规则
+    bool apply;             ///< 完成后是否写入PID
+    int u0;                 ///< 继电器中心输出（PWM）
+    int amp;                ///< 继电器幅值（PWM）
+    bool high;              ///< 当前继电器状态
+    uint32_t ticks;         ///< 已运行周期数（ms）
+    uint32_t last_rise;     ///< 上一次上升切换时刻
+    uint8_t rises;          ///< 上升切换次数
+    int vmax;               ///< 本周期速度最大值
+    int vmin;               ///< 本周期速度最小值
+    uint32_t sum_period;    ///< 有效周期累计（ms）
+    int32_t sum_pp;         ///< 有效峰峰值累计（计数/ms）
+} Autotune;
+
+static Autotune tune;
+
+/* 私有函数声明 */
+static void Autotune_Finish(bool success);
+
+bool Autotune_Start(MotorID id, int relay_amp, AutotuneRule rule, bool apply) {
+    if (tune.active || id > MOTOR_D || rule >= AUTOTUNE_RULE_COUNT || relay_amp <= 0) {
+        return false;
+    }
+
+    tune.id = id;
+    tune.rule = rule;
+    tune.apply = apply;
+    tune.u0 = pwm_outputs[id];
+    tune.amp = (relay_amp > OUTPUT_LIMIT) ? OUTPUT_LIMIT : relay_amp;
+    tune.high = false;
+    tune.ticks = 0;
+    tune.last_rise = 0;
+    tune.rises = 0;
+    tune.vmax = real_speeds[id];
+    tune.vmin = real_speeds[id];
+    tune.sum_period = 0;
+    tune.sum_pp = 0;
+    tune.active = true;
+    motor_status[id] |= MOTOR_FLAG_AUTOTUNE;
+    return true;
+}
+
+void Autotune_Abort(void) {
+    if (tune.active) {
+        Autotune_Finish(false);
+    }
+}
+
+bool Autotune_IsActive(MotorID id) {
+    return tune.active && tune.id == id;
+}
+
+/**
+ * @brief 继电器输出计算
+ */
+int Autotune_Update(MotorID id, int setpoint, int speed) {
+    int error = setpoint - speed;
+
+    // 1. 超时保护
+    if (++tune.ticks > AUTOTUNE_TIMEOUT_MS) {
+        Autotune_Finish(false);
+        return pwm_outputs[id];
+    }
+
+    // 2. 记录本周期极值
+    if (speed > tune.vmax) tune.vmax = speed;
+    if (speed < tune.vmin) tune.vmin = speed;
+
+    // 3. 带回差的继电器；每次上升切换完成一个振荡周期
+    if (!tune.high && error > AUTOTUNE_HYSTERESIS) {
+        tune.high = true;
+        if (tune.rises > AUTOTUNE_SKIP_CYCLES) {
+            tune.sum_period += tune.ticks - tune.last_rise;
+            tune.sum_pp += tune.vmax - tune.vmin;
+        }
+        tune.last_rise = tune.ticks;
+        tune.vmax = speed;
+        tune.vmin = speed;
+        if (++tune.rises > AUTOTUNE_SKIP_CYCLES + AUTOTUNE_MEAS_CYCLES) {
+            Autotune_Finish(true);
+            return tune.u0;
+        }
+    } else if (tune.high && error < -AUTOTUNE_HYSTERESIS) {
+        tune.high = false;
+    }
+
+    // 4. 输出 u0 ± d
+    int output = tune.high ? tune.u0 + tune.amp : tune.u0 - tune.amp;
+    if (output > OUTPUT_LIMIT) {
+        output = OUTPUT_LIMIT;
+    } else if (output < -OUTPUT_LIMIT) {
+        output = -OUTPUT_LIMIT;
+    }
+    return output;
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 结束整定：计算 Ku/Tu 与PID参数，上报并按需写入
+ */
+static void Autotune_Finish(bool success) {
+    MotorID id = tune.id;
+    int32_t ku = 0, tu = 0, kp = 0, ki = 0, kd = 0;
+
+    tune.active = false;
+    motor_status[id] &= (uint16_t)~MOTOR_FLAG_AUTOTUNE;
+    PID_Bumpless(id);  // 从继电器输出无扰切回PID
+
+    if (success) {
+        // a、h 用 Q8 表示以保留小数：a = 峰峰值 / 2
+        int64_t a_q8 = ((int64_t)tune.sum_pp << 8) / (2 * AUTOTUNE_MEAS_CYCLES);
+        int64_t h_q8 = (int64_t)AUTOTUNE_HYSTERESIS << 8;
+        tu = (int32_t)(tune.sum_period / AUTOTUNE_MEAS_CYCLES);
+
+        if (a_q8 <= h_q8 || tu <= 0) {
+            success = false;
+        } else {
+            // Ku×100 = 4d·100 / (π·sqrt(a²-h²))，π 取 3142/1000
+            uint32_t den_q8 = Fix_Isqrt64((uint64_t)(a_q8 * a_q8 - h_q8 * h_q8));
+            if (den_q8 == 0) {
+                den_q8 = 1;
+            }
+            ku = (int32_t)(((int64_t)4 * tune.amp * 100 * 256 * 1000) / ((int64_t)3142 * den_q8));
+
+            const TuneRule *r = &tune_rules[tune.rule];
+            kp = (int32_t)(((int64_t)ku * r->kp) / 1000);
+            ki = (int32_t)(((int64_t)ku * r->ki) / (1000 * (int64_t)tu));
+            kd = (int32_t)(((int64_t)ku * r->kd * tu) / 1000);
+        }
+    }
+
+    if (success && tune.apply) {
+        PID_SetParam(id, PID_PARAM_KP, kp);
+        PID_SetParam(id, PID_PARAM_KI, ki);
+        PID_SetParam(id, PID_PARAM_KD, kd);
+    }
+
+    Uart2DmaSendReply(MOTOR_CMD_AUTOTUNE, (uint8_t)id, 0, success ? 1 : 0);
+    if (success) {
+        Uart2DmaSendReply(MOTOR_CMD_AUTOTUNE, (uint8_t)id, 1, ku);
+        Uart2DmaSendReply(MOTOR_CMD_AUTOTUNE, (uint8_t)id, 2, tu);
+        Uart2DmaSendReply(MOTOR_CMD_AUTOTUNE, (uint8_t)id, 3, kp);
+        Uart2DmaSendReply(MOTOR_CMD_AUTOTUNE, (uint8_t)id, 4, ki);
+        Uart2DmaSendReply(MOTOR_CMD_AUTOTUNE, (uint8_t)id, 5, kd);
+    }
+}
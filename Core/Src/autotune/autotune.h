@@ -0,0 +1,69 @@
+/**
+ * @file autotune.h
+ * @brief 速度环继电器反馈自整定（Åström–Hägglund）
+ *
+ * @note 每次只整定一个轴；运行于1kHz控制中断内，由 Update_Motors() 调用。
+ *       结果通过 Uart2DmaSendReply() 以 MOTOR_CMD_AUTOTUNE 应答帧上报：
+ *         idx 0 = 状态（1 成功 / 0 超时或中止）
+ *         idx 1 = Ku × 100（PWM / (计数/ms)）
+ *         idx 2 = Tu（ms）
+ *         idx 3/4/5 = Kp/Ki/Kd（×100，与 PID_SetParam 同单位）
+ */
+
+#ifndef __AUTOTUNE_H
+#define __AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUTOTUNE_HYSTERESIS    1      ///< 继电器回差（计数/ms）
+#define AUTOTUNE_SKIP_CYCLES   2      ///< 丢弃的起振周期数
+#define AUTOTUNE_MEAS_CYCLES   4      ///< 参与平均的振荡周期数
+#define AUTOTUNE_TIMEOUT_MS    5000   ///< 超时（ms）
+
+/**
+ * @brief 整定规则
+ */
+typedef enum {
+    AUTOTUNE_RULE_ZN_PI = 0,       ///< Ziegler–Nichols PI
+    AUTOTUNE_RULE_ZN_PID,          ///< Ziegler–Nichols PID
+    AUTOTUNE_RULE_TL_PI,           ///< Tyreus–Luyben PI（更保守）
+    AUTOTUNE_RULE_NO_OVERSHOOT,    ///< 无超调 PID
+    AUTOTUNE_RULE_COUNT
+} AutotuneRule;
+
+/**
+ * @brief 启动自整定
+ * @param id 电机标识
+ * @param relay_amp 继电器幅值（PWM，围绕当前输出上下摆动）
+ * @param rule 整定规则
+ * @param apply 完成后是否直接写入PID参数
+ * @return 已有轴在整定或参数无效返回false
+ */
+bool Autotune_Start(MotorID id, int relay_amp, AutotuneRule rule, bool apply);
+
+/**
+ * @brief 中止自整定（PID参数不变）
+ */
+void Autotune_Abort(void);
+
+bool Autotune_IsActive(MotorID id);
+
+/**
+ * @brief 继电器输出计算（1kHz中断中调用）
+ * @param setpoint 目标速度（继电器切换的参考）
+ * @param speed 实际速度
+ * @return PWM输出值（±OUTPUT_LIMIT）
+ */
+int Autotune_Update(MotorID id, int setpoint, int speed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUTOTUNE_H */
@@ -0,0 +1,376 @@
+/**
+ * @file bode.c
+ * @brief 速度环频率响应在线测量（全整型实现）
+ *
+ * 原理：
+ * 1. 激励 d = A·sin(φ)，φ 每周期增加 f·2^32/1000，相位回绕即一个整周期结束
+ * 2. 在整数个周期内累加 Σx·sin、Σx·cos、Σx、Σsin、Σcos，
+ *    扣除直流：S = Σx·sin - Σx·Σsin/n（余弦同理）
+ * 3. X = S + jC 的幅值用整数平方根、相角用 CORDIC 反正切求得，
+ *    H = X_num / X_den：|H| = |X_num|/|X_den|，∠H = ∠X_num - ∠X_den
+ */
+
+#include "bode.h"
+#include "../fixmath/fixmath.h"
+#include "../autotune/autotune.h"
+#include "../motor_cal/motor_cal.h"
+#include "../sysid/sysid.h"
+#include "../motor_cmd/motor_cmd.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
+
+#define BODE_NONE        0xFFu                  ///< 无轴运行
+#define PHASE_PER_DHZ    (FIX_PHASE_PER_HZ_1KHZ / 10u)  ///< 0.1Hz 对应的相位增量
+#define REPORT_NONE      0xFFFFu
+
+/**
+ * @brief 单路信号的相关累加
+ */
+typedef struct {
+    int64_t s;      ///< Σx·sin（Q15）
+    int64_t c;      ///< Σx·cos（Q15）
+    int64_t sum;    ///< Σx
+} BodeAcc;
+
+/**
+ * @brief 单个频点的结果
+ */
+typedef struct {
+    int32_t gain;   ///< |H|（Q16）
+    int32_t phase;  ///< ∠H（0.01°）
+} BodePoint;
+
+static int32_t bode_params[BODE_PARAM_COUNT];
+static uint16_t freq_list[BODE_MAX_POINTS];   ///< 频率表（0.1Hz，0 = 结束）
+static BodePoint results[BODE_MAX_POINTS];
+
+static uint8_t active_id = BODE_NONE;   ///< 运行中的轴
+static uint8_t result_id;               ///< 结果所属的轴
+static uint8_t point;                   ///< 当前频点序号
+static uint8_t result_count;            ///< 已完成频点数
+static uint32_t phase;                  ///< 激励相位
+static uint32_t phase_inc;              ///< 每周期相位增量
+static uint32_t ticks;                  ///< 当前阶段已运行周期数
+static bool measuring;                  ///< false = 过渡等待，true = 相关累加
+static int last_pid;                    ///< 本周期PID输出（Q6）
+static int last_ref;                    ///< 本周期速度目标（计数/ms）
+static BodeAcc acc_num;                 ///< 响应信号累加
+static BodeAcc acc_den;                 ///< 参考信号累加
+static int64_t sum_sin;                 ///< Σsin（Q15）
+static int64_t sum_cos;                 ///< Σcos（Q15）
+static uint32_t acc_n;                  ///< 累加点数
+static uint16_t report_pos = REPORT_NONE;  ///< 上报进度（应答帧序号）
+
+/* 私有函数声明 */
+static void Bode_BeginPoint(void);
+static void Bode_ResetAcc(void);
+static void Bode_Accumulate(BodeAcc *acc, int32_t x, int32_t s, int32_t c);
+static int Bode_Vector(const BodeAcc *acc, int32_t *re, int32_t *im);
+static void Bode_ComputePoint(void);
+static void Bode_Finish(void);
+
+void Bode_Init(void) {
+    static const uint16_t default_list[] = { 10, 20, 50, 100, 200, 500, 1000, 2000 };
+
+    bode_params[BODE_PARAM_MODE] = BODE_MODE_LOOP;
+    bode_params[BODE_PARAM_AMPLITUDE] = 50;
+    bode_params[BODE_PARAM_OFFSET] = 300;
+    bode_params[BODE_PARAM_SETTLE_MS] = 200;
+    bode_params[BODE_PARAM_MEASURE_MS] = 500;
+    for (uint16_t i = 0; i < BODE_MAX_POINTS; i++) {
+        freq_list[i] = (i < sizeof(default_list) / sizeof(default_list[0])) ? default_list[i] : 0u;
+    }
+    active_id = BODE_NONE;
+    result_id = 0;
+    result_count = 0;
+    report_pos = REPORT_NONE;
+}
+
+bool Bode_SetParam(BodeParam param, int32_t value) {
+    int32_t lo;
+    int32_t hi;
+
+    if (active_id != BODE_NONE) {
+        return false;
+    }
+    switch (param) {
+        case BODE_PARAM_MODE:       lo = 0; hi = BODE_MODE_TRACK; break;
+        case BODE_PARAM_AMPLITUDE:  lo = 1; hi = OUTPUT_LIMIT; break;
+        case BODE_PARAM_OFFSET:     lo = -OUTPUT_LIMIT; hi = OUTPUT_LIMIT; break;
+        case BODE_PARAM_SETTLE_MS:  lo = 0; hi = 10000; break;
+        case BODE_PARAM_MEASURE_MS: lo = 1; hi = 10000; break;
+        default: return false;
+    }
+    if (value < lo || value > hi) {
+        return false;
+    }
+    bode_params[param] = value;
+    return true;
+}
+
+bool Bode_SetFreq(uint16_t slot, int32_t freq_dhz) {
+    if (active_id != BODE_NONE || slot >= BODE_MAX_POINTS ||
+        freq_dhz < 0 || freq_dhz > BODE_FREQ_MAX) {
+        return false;
+    }
+    freq_list[slot] = (uint16_t)freq_dhz;
+    return true;
+}
+
+bool Bode_Start(MotorID id) {
+    if (active_id != BODE_NONE || freq_list[0] == 0u ||
+        Autotune_IsActive(id) || MotorCal_IsActive(id) || Sysid_IsActive(id)) {
+        return false;
+    }
+    active_id = (uint8_t)id;
+    result_id = (uint8_t)id;
+    point = 0;
+    result_count = 0;
+    report_pos = REPORT_NONE;
+    phase = 0;
+    last_pid = 0;
+    last_ref = 0;
+    Bode_BeginPoint();
+    motor_status[id] |= MOTOR_FLAG_BODE;
+    PID_Bumpless(id);
+    return true;
+}
+
+void Bode_Abort(void) {
+    if (active_id != BODE_NONE) {
+        Bode_Finish();
+    }
+}
+
+bool Bode_IsActive(MotorID id) {
+    return active_id == (uint8_t)id;
+}
+
+BodeMode Bode_GetMode(void) {
+    return (BodeMode)bode_params[BODE_PARAM_MODE];
+}
+
+int Bode_Reference(MotorID id, int setpoint) {
+    (void)id;
+    if (bode_params[BODE_PARAM_MODE] != BODE_MODE_TRACK) {
+        return setpoint;
+    }
+    last_ref = setpoint + ((bode_params[BODE_PARAM_AMPLITUDE] * Fix_SinQ15(phase)) >> 15);
+    return last_ref;
+}
+
+int Bode_Update(MotorID id, int pid_output) {
+    // 激励（Q6）：A·64·sin / 2^15
+    int32_t exc = (bode_params[BODE_PARAM_AMPLITUDE] * Fix_SinQ15(phase)) >> (15 - PWM_FRAC_BITS);
+    int32_t out;
+
+    (void)id;
+    last_pid = pid_output;
+    switch (bode_params[BODE_PARAM_MODE]) {
+        case BODE_MODE_PLANT:
+            out = bode_params[BODE_PARAM_OFFSET] * PWM_FINE_SCALE + exc;
+            break;
+        case BODE_MODE_LOOP:
+            out = pid_output + exc;
+            break;
+        default:
+            out = pid_output;
+            break;
+    }
+    if (out > OUTPUT_LIMIT_FINE) {
+        out = OUTPUT_LIMIT_FINE;
+    } else if (out < -OUTPUT_LIMIT_FINE) {
+        out = -OUTPUT_LIMIT_FINE;
+    }
+    return (int)out;
+}
+
+void Bode_Record(MotorID id, int fine, int delta) {
+    if (active_id != (uint8_t)id) {
+        return;
+    }
+
+    // 1. 相关累加（本周期激励相位）
+    if (measuring) {
+        int32_t s = Fix_SinQ15(phase);
+        int32_t c = Fix_CosQ15(phase);
+
+        switch (bode_params[BODE_PARAM_MODE]) {
+            case BODE_MODE_PLANT:
+                Bode_Accumulate(&acc_num, delta * PWM_FINE_SCALE, s, c);  // 速度换算到Q6，增益单位 (计数/ms)/PWM
+                Bode_Accumulate(&acc_den, fine, s, c);
+                break;
+            case BODE_MODE_LOOP:
+                Bode_Accumulate(&acc_num, last_pid, s, c);
+                Bode_Accumulate(&acc_den, fine, s, c);
+                break;
+            default:
+                Bode_Accumulate(&acc_num, delta, s, c);
+                Bode_Accumulate(&acc_den, last_ref, s, c);
+                break;
+        }
+        sum_sin += s;
+        sum_cos += c;
+        acc_n++;
+    }
+
+    // 2. 推进相位；回绕即一个整周期结束，阶段切换只在周期边界进行
+    uint32_t prev = phase;
+    phase += phase_inc;
+    ticks++;
+    if (phase >= prev) {
+        return;
+    }
+    if (!measuring) {
+        if (ticks >= (uint32_t)bode_params[BODE_PARAM_SETTLE_MS]) {
+            measuring = true;
+            ticks = 0;
+            Bode_ResetAcc();
+        }
+        return;
+    }
+    if (ticks < (uint32_t)bode_params[BODE_PARAM_MEASURE_MS]) {
+        return;
+    }
+
+    Bode_ComputePoint();
+    if (report_pos == REPORT_NONE) {
+        report_pos = (uint16_t)(2u * point);
+    }
+    result_count = (uint8_t)(point + 1u);
+    point++;
+    if (point >= BODE_MAX_POINTS || freq_list[point] == 0u) {
+        Bode_Finish();
+    } else {
+        Bode_BeginPoint();
+    }
+}
+
+bool Bode_Report(void) {
+    if (active_id != BODE_NONE || result_count == 0u) {
+        return false;
+    }
+    report_pos = 0;
+    return true;
+}
+
+void Bode_Task(void) {
+    while (report_pos != REPORT_NONE) {
+        uint16_t p = (uint16_t)(report_pos >> 1);
+        bool ok;
+
+        if (p >= result_count) {
+            if (active_id != BODE_NONE) {
+                return;  // 后续频点尚未完成
+            }
+            if (!Uart2DmaSendReply(MOTOR_CMD_BODE, result_id, 0, result_count)) {
+                return;
+            }
+            report_pos = REPORT_NONE;
+            return;
+        }
+        if ((report_pos & 1u) == 0u) {
+            ok = Uart2DmaSendReply(MOTOR_CMD_BODE_GAIN, result_id, p, results[p].gain);
+        } else {
+            ok = Uart2DmaSendReply(MOTOR_CMD_BODE_PHASE, result_id, p, results[p].phase);
+        }
+        if (!ok) {
+            return;  // 队列满，下个周期继续
+        }
+        report_pos++;
+    }
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 切换到当前频点（相位连续，不重置）
+ */
+static void Bode_BeginPoint(void) {
+    phase_inc = (uint32_t)freq_list[point] * PHASE_PER_DHZ;
+    ticks = 0;
+    measuring = false;
+}
+
+static void Bode_ResetAcc(void) {
+    acc_num.s = 0;
+    acc_num.c = 0;
+    acc_num.sum = 0;
+    acc_den = acc_num;
+    sum_sin = 0;
+    sum_cos = 0;
+    acc_n = 0;
+}
+
+static void Bode_Accumulate(BodeAcc *acc, int32_t x, int32_t s, int32_t c) {
+    acc->s += (int64_t)x * s;
+    acc->c += (int64_t)x * c;
+    acc->sum += x;
+}
+
+/**
+ * @brief 扣除直流后的复数相关值，归一化到 Fix_Atan2 的输入范围
+ * @param re,im 输出：同相/正交分量（已右移）
+ * @return 右移位数
+ */
+static int Bode_Vector(const BodeAcc *acc, int32_t *re, int32_t *im) {
+    int64_t s = acc->s - (acc->sum * sum_sin) / (int64_t)acc_n;
+    int64_t c = acc->c - (acc->sum * sum_cos) / (int64_t)acc_n;
+    int shift = 0;
+
+    while (s >= FIX_ATAN2_INPUT_MAX || s <= -FIX_ATAN2_INPUT_MAX ||
+           c >= FIX_ATAN2_INPUT_MAX || c <= -FIX_ATAN2_INPUT_MAX) {
+        s /= 2;
+        c /= 2;
+        shift++;
+    }
+    *re = (int32_t)s;
+    *im = (int32_t)c;
+    return shift;
+}
+
+/**
+ * @brief 由相关累加计算当前频点的增益与相位
+ */
+static void Bode_ComputePoint(void) {
+    int32_t num_re, num_im, den_re, den_im;
+    int shift = Bode_Vector(&acc_num, &num_re, &num_im) - Bode_Vector(&acc_den, &den_re, &den_im);
+    uint32_t num_mag = Fix_Isqrt64((uint64_t)((int64_t)num_re * num_re + (int64_t)num_im * num_im));
+    uint32_t den_mag = Fix_Isqrt64((uint64_t)((int64_t)den_re * den_re + (int64_t)den_im * den_im));
+    uint32_t angle = Fix_Atan2(num_im, num_re) - Fix_Atan2(den_im, den_re);
+    uint64_t gain = num_mag;
+
+    if (bode_params[BODE_PARAM_MODE] == BODE_MODE_LOOP) {
+        angle += 0x80000000u;  // L = -c / u
+    }
+
+    // |H|（Q16）= num_mag / den_mag · 2^(shift + 16)
+    shift += 16;
+    if (den_mag == 0u) {
+        gain = 0;
+    } else if (shift > 32) {
+        gain = INT32_MAX;
+    } else {
+        gain = (shift >= 0) ? (gain << shift) : (gain >> ((-shift > 63) ? 63 : -shift));
+        gain /= den_mag;
+        if (gain > INT32_MAX) {
+            gain = INT32_MAX;
+        }
+    }
+
+    results[point].gain = (int32_t)gain;
+    results[point].phase = Fix_PhaseToCdeg(angle);
+}
+
+/**
+ * @brief 结束扫频（结果与完成应答由 Bode_Task() 依次上报）
+ */
+static void Bode_Finish(void) {
+    MotorID id = (MotorID)active_id;
+
+    active_id = BODE_NONE;
+    motor_status[id] &= (uint16_t)~MOTOR_FLAG_BODE;
+    PID_Bumpless(id);
+    if (report_pos == REPORT_NONE) {
+        report_pos = (uint16_t)(2u * result_count);  // 无待发结果，只发完成应答
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file bode.h
+ * @brief 速度环频率响应（Bode）在线测量：正弦扫频 + 片上相关解调
+ *
+ * @note 单轴运行，由 Update_Motors() 调用。按频率表逐点注入正弦激励 A·sin(ωt)，
+ *       每个频率先等待过渡过程（≥ settle 时间，并对齐到整周期起点），
+ *       再在整数个周期（≥ measure 时间）内累加两路信号与 sin/cos 的乘积：
+ *         X = Σx·sin(ωt) + j·Σx·cos(ωt)   （已扣除直流分量）
+ *       响应 H = X_num / X_den，只上报增益与相位，不传原始采样。
+ *       测量模式：
+ *       - PLANT（开环对象）：输出 = 偏置 + 激励，PID冻结；
+ *         H = 速度 / 占空比，增益单位 (计数/ms)/PWM
+ *       - LOOP（开环传递函数）：闭环运行，激励叠加在PID输出上（对象输入处注入）；
+ *         u = c + d，L = -c / u，由此可读穿越频率、相位裕度与增益裕度
+ *       - TRACK（闭环跟踪）：激励叠加在速度目标上（幅值单位 计数/ms）；
+ *         T = 速度 / 目标
+ *       结果：每完成一个频率以 MOTOR_CMD_BODE_GAIN（idx=频点序号，value=|H|，Q16）
+ *       与 MOTOR_CMD_BODE_PHASE（value=∠H，0.01°，-18000~18000）应答；
+ *       全部完成后以 MOTOR_CMD_BODE 应答 idx0 频点数。
+ */
+
+#ifndef __BODE_H
+#define __BODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BODE_MAX_POINTS    16     ///< 频率表最大点数
+#define BODE_FREQ_MAX      4000   ///< 最高频率（0.1Hz，400Hz，每周期至少 2.5 个采样）
+
+/**
+ * @brief 测量模式
+ */
+typedef enum {
+    BODE_MODE_PLANT = 0,  ///< 开环对象：占空比 -> 速度
+    BODE_MODE_LOOP,       ///< 开环传递函数 L（对象输入处注入）
+    BODE_MODE_TRACK       ///< 闭环跟踪 T：目标 -> 速度
+} BodeMode;
+
+/**
+ * @brief 可调参数编号（MOTOR_CMD_BODE_PARAM 的 idx）
+ */
+typedef enum {
+    BODE_PARAM_MODE = 0,      ///< 测量模式（BodeMode）
+    BODE_PARAM_AMPLITUDE,     ///< 激励幅值（PLANT/LOOP：占空比；TRACK：计数/ms）
+    BODE_PARAM_OFFSET,        ///< PLANT 模式偏置（占空比，±1000）
+    BODE_PARAM_SETTLE_MS,     ///< 每个频率的过渡等待时间（ms）
+    BODE_PARAM_MEASURE_MS,    ///< 每个频率的最短积分时间（ms，自动延长到整周期）
+    BODE_PARAM_COUNT
+} BodeParam;
+
+/**
+ * @brief 初始化（默认：LOOP 模式，幅值 50，等待 200ms，积分 500ms，
+ *        频率表 1/2/5/10/20/50/100/200 Hz）
+ */
+void Bode_Init(void);
+
+/**
+ * @brief 修改参数（运行中不可修改）
+ * @return 参数编号无效、数值越界或正在运行返回false
+ */
+bool Bode_SetParam(BodeParam param, int32_t value);
+
+/**
+ * @brief 设置频率表的一项
+ * @param slot 序号（0 ~ BODE_MAX_POINTS-1）
+ * @param freq_dhz 频率（0.1Hz），0 表示频率表在此结束
+ * @return 序号/频率越界或正在运行返回false
+ */
+bool Bode_SetFreq(uint16_t slot, int32_t freq_dhz);
+
+/**
+ * @brief 在单轴上启动扫频
+ * @return 已有轴在运行、频率表为空或该轴被其他功能接管返回false
+ */
+bool Bode_Start(MotorID id);
+
+/**
+ * @brief 中止扫频（已完成频点的结果保留）
+ */
+void Bode_Abort(void);
+
+bool Bode_IsActive(MotorID id);
+
+BodeMode Bode_GetMode(void);
+
+/**
+ * @brief 速度目标（TRACK 模式叠加激励，其余模式原样返回）
+ */
+int Bode_Reference(MotorID id, int setpoint);
+
+/**
+ * @brief 该轴输出（1kHz中断中调用）
+ * @param pid_output PID输出（Q6），PLANT 模式忽略
+ * @return 该轴输出（Q6，±OUTPUT_LIMIT_FINE）
+ */
+int Bode_Update(MotorID id, int pid_output);
+
+/**
+ * @brief 相关累加并推进激励相位（整条输出链路之后调用）
+ * @param fine 实际施加的控制器输出（Q6）
+ * @param delta 本周期编码器增量
+ */
+void Bode_Record(MotorID id, int fine, int delta);
+
+/**
+ * @brief 请求重新上报已完成频点的结果
+ * @return 正在运行或无结果返回false
+ */
+bool Bode_Report(void);
+
+/**
+ * @brief 结果上报（每个控制周期调用，按应答队列余量逐条发送）
+ */
+void Bode_Task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BODE_H */
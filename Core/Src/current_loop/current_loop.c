@@ -0,0 +1,176 @@
+/**
+ * @file current_loop.c
+ * @brief 电流（转矩）内环（全整型实现）
+ *
+ * 原理：
+ * 1. 控制周期把速度PID输出按电流限幅换算成ADC计数域的目标 ref
+ * 2. 每个PWM周期注入组转换完成后：e = ref - i，u = (Kp·e + ∫Ki·e) / 256
+ * 3. 输出饱和且误差同向时停止积分（条件积分抗饱和）
+ * 电流在ADC计数域计算，中断内不做单位换算。
+ */
+
+#include "current_loop.h"
+#include "../adc_sense/adc_sense.h"
+#include "../motor/ax_motor.h"
+#include "../motor_cal/motor_cal.h"
+#include "../vbus_comp/vbus_comp.h"
+
+#define INTEG_LIMIT   (OUTPUT_LIMIT * 256)  ///< 积分限幅（Q8 占空比）
+
+/**
+ * @brief 单轴电流环状态
+ */
+typedef struct {
+    volatile bool enabled;      ///< 是否启用
+    volatile int32_t ref;       ///< 电流目标（ADC计数，带符号）
+    int32_t limit_ma;           ///< 电流限幅（mA）
+    int32_t kp;                 ///< 比例系数（Q8）
+    int32_t ki;                 ///< 积分系数（Q8）
+    int32_t integ;              ///< 积分（Q8 占空比）
+    volatile int duty;          ///< 最近一次输出占空比
+} CurrentAxis;
+
+static CurrentAxis cur_axes[4];
+static CycleMeter cur_meter;
+
+void CurrentLoop_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        cur_axes[i].enabled = false;
+        cur_axes[i].ref = 0;
+        cur_axes[i].limit_ma = CURRENT_LIMIT_DEFAULT;
+        cur_axes[i].kp = CURRENT_KP_DEFAULT;
+        cur_axes[i].ki = CURRENT_KI_DEFAULT;
+        cur_axes[i].integ = 0;
+        cur_axes[i].duty = 0;
+        Motor_SetFastLoop((MotorChannel)i, false);
+    }
+    CycleMeter_Reset(&cur_meter);
+    AdcSense_EnableIrq(false);
+}
+
+bool CurrentLoop_Enable(MotorID id, bool enable) {
+    CurrentAxis *axis = &cur_axes[id];
+    bool any = false;
+
+    if (enable && (MotorCal_IsActive(id) || !Motor_IsCenterAligned())) {
+        return false;  // 边沿对齐时电流采样落在导通边沿，不可用于闭环
+    }
+    if (enable && !axis->enabled) {
+        // 无扰切入：积分从当前占空比开始，目标取实测电流，
+        // 速度PID按实测电流对应的输出重建积分
+        int32_t limit_raw = AdcSense_CurrentToRaw(axis->limit_ma);
+        int32_t meas = AdcSense_GetCurrentRaw(id);
+        if (meas < 0) {
+            meas = -meas;
+        }
+        if (meas > limit_raw) {
+            meas = limit_raw;
+        }
+        if (pwm_outputs[id] < 0) {
+            meas = -meas;  // 单向采样，方向取当前驱动方向
+        }
+        axis->integ = pwm_outputs[id] * 256;
+        axis->duty = pwm_outputs[id];
+        axis->ref = meas;
+        PID_Bumpless(id);
+        PID_TrackOutput(id, (limit_raw > 0) ? (int)((int64_t)meas * OUTPUT_LIMIT_FINE / limit_raw) : 0);
+    } else if (!enable && axis->enabled) {
+        // 无扰切出：最终占空比逐级逆换算回控制器域，速度PID按此重建积分
+        int duty = VbusComp_Remove(axis->duty * PWM_FINE_SCALE);
+        PID_Bumpless(id);
+        PID_TrackOutput(id, MotorCal_Unlinearize(id, duty));
+    }
+    axis->enabled = enable;
+    Motor_SetFastLoop((MotorChannel)id, enable);
+
+    for (int i = 0; i < 4; i++) {
+        any = any || cur_axes[i].enabled;
+    }
+    AdcSense_EnableIrq(any);
+    return true;
+}
+
+bool CurrentLoop_IsEnabled(MotorID id) {
+    return cur_axes[id].enabled;
+}
+
+void CurrentLoop_SetLimit(MotorID id, int32_t limit_ma) {
+    cur_axes[id].limit_ma = (limit_ma < 0) ? -limit_ma : limit_ma;
+}
+
+void CurrentLoop_SetKp(MotorID id, int32_t kp) {
+    cur_axes[id].kp = (kp < 0) ? 0 : kp;
+}
+
+void CurrentLoop_SetKi(MotorID id, int32_t ki) {
+    cur_axes[id].ki = (ki < 0) ? 0 : ki;
+}
+
+/**
+ * @brief 更新电流目标
+ * @note ref = fine / OUTPUT_LIMIT_FINE × 限幅，换算为ADC计数；
+ *       |fine| ≤ OUTPUT_LIMIT_FINE，因此目标不会超过电流限幅
+ */
+void CurrentLoop_SetRef(MotorID id, int fine) {
+    CurrentAxis *axis = &cur_axes[id];
+    int32_t limit_raw = AdcSense_CurrentToRaw(axis->limit_ma);
+
+    axis->ref = (int32_t)(((int64_t)fine * limit_raw) / OUTPUT_LIMIT_FINE);
+}
+
+int CurrentLoop_GetDuty(MotorID id) {
+    return cur_axes[id].duty;
+}
+
+/**
+ * @brief 电流PI计算（每个PWM周期一次）
+ */
+void CurrentLoop_IRQHandler(void) {
+    ADC1->SR = ~ADC_SR_JEOC;
+    CycleMeter_Begin(&cur_meter);
+
+    for (int i = 0; i < 4; i++) {
+        CurrentAxis *axis = &cur_axes[i];
+        if (!axis->enabled) {
+            continue;
+        }
+
+        // 1. 测量：单向采样，方向取上一次输出的符号
+        int32_t meas = AdcSense_GetCurrentRaw((MotorID)i);
+        if (meas < 0) {
+            meas = -meas;
+        }
+        if (axis->duty < 0) {
+            meas = -meas;
+        }
+
+        // 2. PI
+        int32_t error = axis->ref - meas;
+        int32_t p = axis->kp * error;
+        int32_t u = (p + axis->integ) / 256;
+
+        // 3. 输出限幅与条件积分
+        if (u > OUTPUT_LIMIT) {
+            u = OUTPUT_LIMIT;
+        } else if (u < -OUTPUT_LIMIT) {
+            u = -OUTPUT_LIMIT;
+        }
+        if (!((u == OUTPUT_LIMIT && error > 0) || (u == -OUTPUT_LIMIT && error < 0))) {
+            axis->integ += axis->ki * error;
+            if (axis->integ > INTEG_LIMIT) {
+                axis->integ = INTEG_LIMIT;
+            } else if (axis->integ < -INTEG_LIMIT) {
+                axis->integ = -INTEG_LIMIT;
+            }
+        }
+
+        axis->duty = (int)u;
+        Motor_OutPutSingle((MotorChannel)i, (int)u);
+    }
+
+    CycleMeter_End(&cur_meter);
+}
+
+CycleMeter *CurrentLoop_GetMeter(void) {
+    return &cur_meter;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file current_loop.h
+ * @brief 电流（转矩）内环，级联在速度PID之后
+ *
+ * @note 开启后速度PID输出（±OUTPUT_LIMIT）解释为电流目标（±电流限幅），
+ *       电流PI在 ADC 注入转换完成中断（与PWM同步）中计算占空比并直接写入该通道。
+ *       采样电阻为单向低边采样时，电流符号取当前驱动方向。
+ *       中断优先级：ADC/TIM1更新为0，其余外设为1（见 main.c）。
+ */
+
+#ifndef __CURRENT_LOOP_H
+#define __CURRENT_LOOP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+#include "../cycle_meter/cycle_meter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 默认参数 --------------------------------------------------------------*/
+#define CURRENT_LIMIT_DEFAULT    2000   ///< 电流限幅（mA）
+#define CURRENT_KP_DEFAULT       40     ///< 比例系数（占空比/ADC计数，Q8）
+#define CURRENT_KI_DEFAULT       4      ///< 积分系数（占空比/ADC计数/PWM周期，Q8）
+
+/**
+ * @brief 初始化（所有轴关闭电流环）
+ */
+void CurrentLoop_Init(void);
+
+/**
+ * @brief 开关单轴电流环
+ * @note 开启时电流积分以当前占空比初始化、目标取实测电流，速度PID按实测电流重建积分；
+ *       关闭时速度PID按最后一次电流环占空比重建积分，两个方向均无扰切换
+ * @return 该轴正在标定或PWM为边沿对齐（电流采样不在导通中点）时返回false
+ */
+bool CurrentLoop_Enable(MotorID id, bool enable);
+
+bool CurrentLoop_IsEnabled(MotorID id);
+
+void CurrentLoop_SetLimit(MotorID id, int32_t limit_ma);
+void CurrentLoop_SetKp(MotorID id, int32_t kp);
+void CurrentLoop_SetKi(MotorID id, int32_t ki);
+
+/**
+ * @brief 更新电流目标（1kHz控制周期中调用）
+ * @param fine 速度PID输出（Q6，±OUTPUT_LIMIT_FINE），满幅对应电流限幅
+ */
+void CurrentLoop_SetRef(MotorID id, int fine);
+
+/**
+ * @brief 最近一次电流PI输出的占空比（±OUTPUT_LIMIT）
+ */
+int CurrentLoop_GetDuty(MotorID id);
+
+/**
+ * @brief 电流PI计算（ADC注入转换完成中断中调用）
+ */
+void CurrentLoop_IRQHandler(void);
+
+/**
+ * @brief 电流环中断耗时统计
+ */
+CycleMeter *CurrentLoop_GetMeter(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CURRENT_LOOP_H */
@@ -0,0 +1,23 @@
+/**
+ * @file cycle_meter.c
+ * @brief 基于 DWT 周期计数器的执行时间测量
+ */
+
+#include "cycle_meter.h"
+
+void CycleMeter_Init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void CycleMeter_Reset(CycleMeter *m) {
+    m->last = 0;
+    m->max = 0;
+    m->sum = 0;
+    m->count = 0;
+}
+
+uint32_t CycleMeter_Average(const CycleMeter *m) {
+    return (m->count != 0u) ? m->sum / m->count : 0u;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file cycle_meter.h
+ * @brief 基于 DWT 周期计数器的执行时间测量
+ *
+ * @note 用法：
+ *         CycleMeter_Begin(&m);
+ *         ... 被测代码 ...
+ *         CycleMeter_End(&m);
+ *       统计值单位为CPU周期（72MHz 下 72 周期 = 1µs）。
+ */
+
+#ifndef __CYCLE_METER_H
+#define __CYCLE_METER_H
+
+#include <stdint.h>
+#include "main.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 单个测量点的统计
+ */
+typedef struct {
+    uint32_t start;   ///< 本次开始时的 CYCCNT
+    uint32_t last;    ///< 最近一次耗时
+    uint32_t max;     ///< 最大耗时
+    uint32_t sum;     ///< 累计耗时（用于平均）
+    uint32_t count;   ///< 累计次数
+} CycleMeter;
+
+/**
+ * @brief 使能 DWT 周期计数器（启动时调用一次）
+ */
+void CycleMeter_Init(void);
+
+/**
+ * @brief 清零统计
+ */
+void CycleMeter_Reset(CycleMeter *m);
+
+/**
+ * @brief 平均耗时（周期）
+ */
+uint32_t CycleMeter_Average(const CycleMeter *m);
+
+static inline void CycleMeter_Begin(CycleMeter *m) {
+    m->start = DWT->CYCCNT;
+}
+
+/**
+ * @brief 记录一次耗时（分散在多处的代码可自行累加后一次记录）
+ */
+static inline void CycleMeter_Record(CycleMeter *m, uint32_t dt) {
+    m->last = dt;
+    if (dt > m->max) {
+        m->max = dt;
+    }
+    if (m->count < 0xFFFFu) {  // 约 65536 次后停止累计，平均值保持有效
+        m->sum += dt;
+        m->count++;
+    }
+}
+
+static inline void CycleMeter_End(CycleMeter *m) {
+    CycleMeter_Record(m, DWT->CYCCNT - m->start);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CYCLE_METER_H */
@@ -0,0 +1,105 @@
+/**
+ * @file fixmath.c
+ * @brief 定点数学函数
+ */
+
+#include "fixmath.h"
+
+#define SIN_TABLE_BITS  6                       ///< 四分之一周期 64 段
+#define SIN_TABLE_LEN   ((1 << SIN_TABLE_BITS) + 1)
+#define CORDIC_STEPS    24
+
+/** sin(i·π/128)·32767，i = 0~64 */
+static const int16_t sin_table[SIN_TABLE_LEN] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+/** atan(2^-i)，相位单位（2^32 = 一整周），i = 0~23 */
+static const uint32_t atan_table[CORDIC_STEPS] = {
+     536870912u,  316933406u,  167458907u,   85004756u,   42667331u,   21354465u,
+      10679838u,    5340245u,    2670163u,    1335087u,     667544u,     333772u,
+        166886u,      83443u,      41722u,      20861u,      10430u,       5215u,
+          2608u,       1304u,        652u,        326u,        163u,         81u
+};
+
+int16_t Fix_SinQ15(uint32_t phase) {
+    uint32_t quadrant = phase >> 30;
+    uint32_t x = phase & 0x3FFFFFFFu;  // 象限内相位（30 位）
+
+    if (quadrant & 1u) {
+        x = 0x40000000u - x;           // 第二、四象限镜像
+    }
+
+    // 高 6 位查表，低 24 位插值
+    uint32_t idx = x >> (30 - SIN_TABLE_BITS);
+    uint32_t frac = (x >> (30 - SIN_TABLE_BITS - 16)) & 0xFFFFu;
+    int32_t y;
+    if (idx >= SIN_TABLE_LEN - 1) {
+        y = sin_table[SIN_TABLE_LEN - 1];
+    } else {
+        y = sin_table[idx] + (int32_t)(((sin_table[idx + 1] - sin_table[idx]) * (int32_t)frac) >> 16);
+    }
+
+    return (int16_t)((quadrant & 2u) ? -y : y);
+}
+
+uint32_t Fix_Atan2(int32_t y, int32_t x) {
+    uint32_t angle = 0;
+
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+    // 左半平面先旋转 π，之后向量模式只需覆盖 ±π/2
+    if (x < 0) {
+        x = -x;
+        y = -y;
+        angle = 0x80000000u;
+    }
+    // 小向量先放大，保证迭代移位后仍有足够有效位
+    while (x < (1L << 27) && y < (1L << 27) && y > -(1L << 27)) {
+        x <<= 1;
+        y *= 2;
+    }
+    // 逐次旋转使 y → 0，累加旋转角
+    for (int i = 0; i < CORDIC_STEPS; i++) {
+        int32_t dx = x >> i;
+        int32_t dy = y >> i;
+        if (y > 0) {
+            x += dy;
+            y -= dx;
+            angle += atan_table[i];
+        } else {
+            x -= dy;
+            y += dx;
+            angle -= atan_table[i];
+        }
+    }
+    return angle;
+}
+
+uint32_t Fix_Isqrt64(uint64_t x) {
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file fixmath.h
+ * @brief 定点数学函数（无FPU，供激励信号生成、频率响应等使用）
+ *
+ * @note 相位统一用 32 位无符号整数表示一整周（0 ~ 2^32 对应 0 ~ 2π），
+ *       相位累加自然回绕，无需取模。
+ */
+
+#ifndef __FIXMATH_H
+#define __FIXMATH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FIX_PHASE_PER_HZ_1KHZ  4294967ul   ///< 1kHz 采样下 1Hz 对应的每周期相位增量（2^32/1000）
+#define FIX_ATAN2_INPUT_MAX    (1L << 29)   ///< Fix_Atan2 输入幅值上限（CORDIC 增益约 1.65，防溢出）
+
+/**
+ * @brief 正弦（四分之一周期查表 + 线性插值）
+ * @param phase 相位（2^32 = 一整周）
+ * @return sin(phase)，Q15（±32767），误差 ≤ 4 LSB
+ */
+int16_t Fix_SinQ15(uint32_t phase);
+
+/**
+ * @brief 余弦
+ */
+static inline int16_t Fix_CosQ15(uint32_t phase) {
+    return Fix_SinQ15(phase + 0x40000000u);
+}
+
+/**
+ * @brief 四象限反正切（CORDIC 向量模式，24 次迭代）
+ * @param y,x 向量坐标，|x|、|y| < FIX_ATAN2_INPUT_MAX
+ * @return 向量角度（2^32 = 一整周，按 int32 解释即 -π ~ π），零向量返回 0
+ */
+uint32_t Fix_Atan2(int32_t y, int32_t x);
+
+/**
+ * @brief 64位整数平方根（逐位法，向下取整）
+ */
+uint32_t Fix_Isqrt64(uint64_t x);
+
+/**
+ * @brief 相位转换为 0.01°（-18000 ~ 18000）
+ */
+static inline int32_t Fix_PhaseToCdeg(uint32_t phase) {
+    return (int32_t)(((int64_t)(int32_t)phase * 36000) >> 32);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FIXMATH_H */
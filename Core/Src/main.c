@@ -29,6 +29,9 @@
 #include "motor\ax_encoder.h"
 #include "motor\motor_pid.h"
 #include "motor_frame/uart2_motor_frame.h"
+#include "adc_sense/adc_sense.h"
+#include "current_loop/current_loop.h"
+#include "cycle_meter/cycle_meter.h"
 #include <stdarg.h>
 #include <string.h>
 /* USER CODE END Includes */
@@ -107,7 +110,18 @@ int main(void)
   /* USER CODE BEGIN 2 */
   //HAL_Delay(500);
     Encoder_Init();
+    /* 中断优先级：电流环（ADC1_2）与换向（TIM1_UP）为0，其余降为1，
+       保证PWM同步的电流环不被1kHz控制周期与通信中断推迟 */
+    HAL_NVIC_SetPriority(TIM6_IRQn, 1, 0);
+    HAL_NVIC_SetPriority(TIM7_IRQn, 1, 0);
+    HAL_NVIC_SetPriority(TIM8_UP_IRQn, 1, 0);
+    HAL_NVIC_SetPriority(USART2_IRQn, 1, 0);
+    HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 1, 0);
+
+    CycleMeter_Init();
     Motor_Init();
+    AdcSense_Init();
+    CurrentLoop_Init();
     PID_Init();
     MotorFrame_UART2_Init();
     HAL_TIM_Base_Start_IT(&htim7);
@@ -16,11 +16,29 @@
 /* Includes ------------------------------------------------------------------*/
 #include "tim.h"
 #include "ax_encoder.h"
+/* Private types -------------------------------------------------------------*/
+/**
+  * @brief 单路编码器信号完整性状态
+  */
+typedef struct {
+    int16_t last_delta;        ///< 上一次可信增量
+    int16_t max_delta;         ///< 最大可信增量（计数/ms）
+    uint8_t spike_run;         ///< 连续超限次数
+    uint16_t idle_ms;          ///< 有输出且无计数的持续时间
+    int32_t disc_ma;           ///< 断线判定电流上限（mA）
+    uint32_t spikes;           ///< 剔除的异常增量次数
+    uint32_t disconnects;      ///< 断线判定次数
+    uint8_t disconnected;      ///< 当前处于断线状态
+} EncoderHealth;
+
 /* Private variables ---------------------------------------------------------*/
 static int32_t s_position[4] = {100,100,100,100};  ///< 各电机累计位置（A/B/C/D对应索引0/1/2/3）
+static TIM_HandleTypeDef *const s_htim[4] = { &htim2, &htim3, &htim4, &htim5 };
+static EncoderHealth s_health[4];
 
 /* Private function prototypes -----------------------------------------------*/
 static int16_t Encoder_Read(TIM_HandleTypeDef *htim);
+static int16_t Encoder_Sample(EncoderMotorID motor_id);
 
 /* Public functions ---------------------------------------------------------*/
 
@@ -34,6 +52,18 @@ void Encoder_Init(void)
     HAL_TIM_Encoder_Start(&htim3, TIM_CHANNEL_ALL);
     HAL_TIM_Encoder_Start(&htim4, TIM_CHANNEL_ALL);
     HAL_TIM_Encoder_Start(&htim5, TIM_CHANNEL_ALL);
+
+    for (int i = 0; i < 4; i++) {
+        s_health[i].last_delta = 0;
+        s_health[i].max_delta = ENCODER_MAX_DELTA_DEFAULT;
+        s_health[i].spike_run = 0;
+        s_health[i].idle_ms = 0;
+        s_health[i].disc_ma = ENCODER_DISC_MA_DEFAULT;
+        s_health[i].spikes = 0;
+        s_health[i].disconnects = 0;
+        s_health[i].disconnected = 0;
+        Encoder_SetFilter((EncoderMotorID)i, ENCODER_FILTER_DEFAULT);
+    }
 }
 
 /**
@@ -42,9 +72,7 @@ void Encoder_Init(void)
   */
 int16_t GetEncoder_A(void)
 {
-    int16_t delta = Encoder_Read(&htim2);
-    s_position[0] += delta;
-    return delta;
+    return Encoder_Sample(ENCODER_MOTOR_A);
 }
 
 /**
@@ -53,9 +81,7 @@ int16_t GetEncoder_A(void)
   */
 int16_t GetEncoder_B(void)
 {
-    int16_t delta = Encoder_Read(&htim3);
-    s_position[1] += delta;
-    return delta;
+    return Encoder_Sample(ENCODER_MOTOR_B);
 }
 
 /**
@@ -64,9 +90,7 @@ int16_t GetEncoder_B(void)
   */
 int16_t GetEncoder_C(void)
 {
-    int16_t delta = Encoder_Read(&htim4);
-    s_position[2] += delta;
-    return delta;
+    return Encoder_Sample(ENCODER_MOTOR_C);
 }
 
 /**
@@ -75,9 +99,7 @@ int16_t GetEncoder_C(void)
   */
 int16_t GetEncoder_D(void)
 {
-    int16_t delta = Encoder_Read(&htim5);
-    s_position[3] += delta;
-    return delta;
+    return Encoder_Sample(ENCODER_MOTOR_D);
 }
 
 /**
@@ -91,6 +113,17 @@ int32_t GetEncoder_Position(EncoderMotorID motor_id)
     return s_position[motor_id] / 100;
 }
 
+/**
+  * @brief  获取指定电机的原始累计计数（位置环使用）
+  * @param  motor_id 电机标识（ENCODER_MOTOR_A/B/C/D）
+  * @retval 累计脉冲数（未做 /100 缩放，带方向）
+  */
+int32_t GetEncoder_Count(EncoderMotorID motor_id)
+{
+    if (motor_id > ENCODER_MOTOR_D) return 0;
+    return s_position[motor_id];
+}
+
 /**
   * @brief  复位所有编码器位置计数器
   */
@@ -101,8 +134,131 @@ void Encoder_ResetAll(void)
     }
 }
 
+/**
+  * @brief  设置编码器输入数字滤波（TIMx_CCMR1 的 IC1F/IC2F，运行中可改）
+  * @param  motor_id 电机标识
+  * @param  icf 滤波编码 0~15（0 = 不滤波，越大抑制的毛刺越宽）
+  * @retval 1 成功，0 参数无效
+  */
+uint8_t Encoder_SetFilter(EncoderMotorID motor_id, uint8_t icf)
+{
+    if (motor_id > ENCODER_MOTOR_D || icf > 15u) return 0;
+    MODIFY_REG(s_htim[motor_id]->Instance->CCMR1, TIM_CCMR1_IC1F | TIM_CCMR1_IC2F,
+               ((uint32_t)icf << TIM_CCMR1_IC1F_Pos) | ((uint32_t)icf << TIM_CCMR1_IC2F_Pos));
+    return 1;
+}
+
+/**
+  * @brief  设置最大可信增量（超过视为干扰并剔除）
+  * @param  max_delta 计数/ms，按电机最高转速留余量设定
+  */
+void Encoder_SetMaxDelta(EncoderMotorID motor_id, int32_t max_delta)
+{
+    if (motor_id > ENCODER_MOTOR_D) return;
+    if (max_delta < 1) max_delta = 1;
+    if (max_delta > 32767) max_delta = 32767;
+    s_health[motor_id].max_delta = (int16_t)max_delta;
+}
+
+/**
+  * @brief  设置断线判定电流上限（电流高于此值时视为堵转而非断线）
+  */
+void Encoder_SetDisconnectCurrent(EncoderMotorID motor_id, int32_t max_ma)
+{
+    if (motor_id > ENCODER_MOTOR_D) return;
+    s_health[motor_id].disc_ma = (max_ma < 0) ? -max_ma : max_ma;
+}
+
+/**
+  * @brief  断线检测（每个控制周期在读取增量后调用）
+  * @param  duty 上一周期输出占空比（±1000）
+  * @param  current_ma 电机电流（mA）
+  * @note   输出足够大、电流不大（电机在转）却持续无计数，判定为断线；
+  *         恢复计数后自动解除，次数保留
+  */
+void Encoder_CheckDisconnect(EncoderMotorID motor_id, int duty, int32_t current_ma)
+{
+    if (motor_id > ENCODER_MOTOR_D) return;
+    EncoderHealth *h = &s_health[motor_id];
+
+    if (duty < 0) duty = -duty;
+    if (current_ma < 0) current_ma = -current_ma;
+
+    if (h->last_delta != 0) {
+        h->idle_ms = 0;
+        h->disconnected = 0;
+        return;
+    }
+    if (duty < ENCODER_DISC_DUTY || current_ma > h->disc_ma) {
+        h->idle_ms = 0;
+        return;
+    }
+    if (h->idle_ms < ENCODER_DISC_MS) {
+        h->idle_ms++;
+    } else if (!h->disconnected) {
+        h->disconnected = 1;
+        h->disconnects++;
+    }
+}
+
+/**
+  * @brief  是否处于断线状态
+  */
+uint8_t Encoder_IsFaulted(EncoderMotorID motor_id)
+{
+    if (motor_id > ENCODER_MOTOR_D) return 0;
+    return s_health[motor_id].disconnected;
+}
+
+/**
+  * @brief  累计故障次数
+  */
+uint32_t Encoder_GetFaultCount(EncoderMotorID motor_id, EncoderFaultType type)
+{
+    if (motor_id > ENCODER_MOTOR_D) return 0;
+    return (type == ENCODER_FAULT_SPIKE) ? s_health[motor_id].spikes
+                                         : s_health[motor_id].disconnects;
+}
+
+/**
+  * @brief  清零故障计数与断线状态
+  */
+void Encoder_ClearFaults(EncoderMotorID motor_id)
+{
+    if (motor_id > ENCODER_MOTOR_D) return;
+    s_health[motor_id].spikes = 0;
+    s_health[motor_id].disconnects = 0;
+    s_health[motor_id].disconnected = 0;
+    s_health[motor_id].idle_ms = 0;
+}
+
 /* Private functions --------------------------------------------------------*/
 
+/**
+  * @brief  读取增量并做合理性检查
+  * @retval 可信增量；孤立的超限增量视为干扰，以上一次可信增量代替。
+  *         连续超过 ENCODER_SPIKE_RUN 次说明是真实运动（最大可信增量设得过小），
+  *         接受读数，避免速度被永久冻结在旧值
+  */
+static int16_t Encoder_Sample(EncoderMotorID motor_id)
+{
+    EncoderHealth *h = &s_health[motor_id];
+    int16_t delta = Encoder_Read(s_htim[motor_id]);
+
+    if (delta > h->max_delta || delta < -h->max_delta) {
+        if (h->spike_run < ENCODER_SPIKE_RUN) {
+            h->spike_run++;
+            h->spikes++;
+            delta = h->last_delta;
+        }
+    } else {
+        h->spike_run = 0;
+    }
+    h->last_delta = delta;
+    s_position[motor_id] += delta;
+    return delta;
+}
+
 /**
   * @brief  读取单个编码器的脉冲增量（内部使用）
   * @param  htim 定时器句柄指针
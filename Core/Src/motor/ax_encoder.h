@@ -23,6 +23,19 @@ typedef enum {
     ENCODER_MOTOR_D        // 电机D编码器
 } EncoderMotorID;
 
+typedef enum {
+    ENCODER_FAULT_SPIKE = 0,  // 孤立的超限增量（已剔除）
+    ENCODER_FAULT_DISCONNECT  // 有PWM输出但长时间无计数（疑似断线）
+} EncoderFaultType;
+
+/* Defines ------------------------------------------------------------------*/
+#define ENCODER_FILTER_DEFAULT      6     // 输入滤波 ICxF：fDTS/4，N=6（约333ns @72MHz）
+#define ENCODER_MAX_DELTA_DEFAULT   100   // 默认最大可信增量（计数/ms）
+#define ENCODER_SPIKE_RUN           3     // 连续超限超过此次数视为真实运动，不再剔除
+#define ENCODER_DISC_DUTY           300   // 断线判定：最小输出占空比（0~1000）
+#define ENCODER_DISC_MS             300   // 断线判定：持续无计数时间（ms）
+#define ENCODER_DISC_MA_DEFAULT     500   // 断线判定：电流上限（mA），高于此值视为堵转而非断线
+
 static int32_t s_position[4];
 /* Function prototypes ------------------------------------------------------*/
 void Encoder_Init(void);
@@ -31,8 +44,17 @@ int16_t GetEncoder_B(void);
 int16_t GetEncoder_C(void);
 int16_t GetEncoder_D(void);
 int32_t GetEncoder_Position(EncoderMotorID motor_id);
+int32_t GetEncoder_Count(EncoderMotorID motor_id);
 void Encoder_ResetAll(void);
 
+uint8_t Encoder_SetFilter(EncoderMotorID motor_id, uint8_t icf);
+void Encoder_SetMaxDelta(EncoderMotorID motor_id, int32_t max_delta);
+void Encoder_SetDisconnectCurrent(EncoderMotorID motor_id, int32_t max_ma);
+void Encoder_CheckDisconnect(EncoderMotorID motor_id, int duty, int32_t current_ma);
+uint8_t Encoder_IsFaulted(EncoderMotorID motor_id);
+uint32_t Encoder_GetFaultCount(EncoderMotorID motor_id, EncoderFaultType type);
+void Encoder_ClearFaults(EncoderMotorID motor_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,7 +9,10 @@
   * @attention
   * - 使用TIM1的4个通道输出PWM
   * - 需要配合H桥电路控制电机正反转
-  * - 输入速度范围：-1000 ~ +1000（对应占空比0%~100%）
+  * - 输入速度范围：-1000 ~ +1000（对应占空比0%~100%），与PWM频率无关，
+  *   比较值按当前周期计数换算，频率/对齐方式可运行时修改
+  * - 零指令时按驱动模式制动（IN1=IN2=高，短接绕组）或滑行（IN1=IN2=低，高阻）；
+  *   零保持时（Σ-Δ抖动产生的0）保持原方向、占空比0，不改变桥臂状态
   ******************************************************************************
   */
 
@@ -19,10 +22,67 @@
 #include "gpio.h"
 
 /* Private defines -----------------------------------------------------------*/
-#define MOTOR_PWM_MAX     1000   // PWM最大值（对应100%占空比）
+#define MOTOR_PWM_MAX     1000   // PWM最大值（对应100%占空比，归一化，不随频率变化）
+#define PWM_PERIOD_MIN    500    // 周期计数下限（保证占空比分辨率不低于1/500）
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    BRIDGE_COAST = 0,   // IN1=低 IN2=低
+    BRIDGE_FORWARD,     // IN1=高 IN2=低
+    BRIDGE_REVERSE,     // IN1=低 IN2=高
+    BRIDGE_BRAKE        // IN1=高 IN2=高
+} BridgeState;
+
+typedef struct {
+    GPIO_TypeDef* port;   // IN1/IN2 所在端口（两脚同端口，可用BSRR原子切换）
+    uint16_t in1_pin;
+    uint16_t in2_pin;
+    uint32_t pwm_channel;
+} MotorHw;
+
+typedef enum {
+    SWITCH_IDLE = 0,    // 无挂起的换向
+    SWITCH_ARMED,       // 比较值已写0，等待更新事件装载
+    SWITCH_READY        // 比较值0已在本周期生效，可切换IN1/IN2
+} BridgeSwitch;
+
+typedef struct {
+    BridgeState state;          // 当前桥臂状态
+    BridgeSwitch pending;       // 换向进度
+    BridgeState pending_state;  // 换向目标状态
+    uint32_t pending_duty;      // 换向后恢复的比较值
+} MotorBridge;
+
+/* Private variables ---------------------------------------------------------*/
+static const MotorHw motor_hw[4] = {
+    { AIN1_GPIO_Port, AIN1_Pin, AIN2_Pin, TIM_CHANNEL_1 },
+    { BIN1_GPIO_Port, BIN1_Pin, BIN2_Pin, TIM_CHANNEL_2 },
+    { CIN1_GPIO_Port, CIN1_Pin, CIN2_Pin, TIM_CHANNEL_3 },
+    { DIN1_GPIO_Port, DIN1_Pin, DIN2_Pin, TIM_CHANNEL_4 },
+};
+
+static MotorDriveMode drive_modes[4] = {
+    MOTOR_DRIVE_BRAKE, MOTOR_DRIVE_BRAKE, MOTOR_DRIVE_BRAKE, MOTOR_DRIVE_BRAKE
+};
+
+static MotorBridge bridges[4];  // 上电时IN引脚均为低（滑行）
+
+static uint32_t pwm_period = MOTOR_PWM_MAX;  // 100%占空比对应的比较值
+
+static bool fast_owned[4];  // 由电流环（ADC中断）直接驱动的通道，Motor_OutPut 跳过
+
+static bool zero_hold[4];   // 零指令保持原方向（不制动/滑行）
 
 /* Private functions ---------------------------------------------------------*/
 static void Set_Single_Motor(MotorChannel channel, int speed);
+static void Write_Bridge(MotorChannel channel, BridgeState state);
+static uint32_t Get_Tim1_Clock(void);
+
+/* 归一化占空比（0~MOTOR_PWM_MAX）换算为比较值 */
+static inline uint32_t Duty_To_Compare(uint32_t duty)
+{
+    return (duty * pwm_period) / MOTOR_PWM_MAX;
+}
 
 /* Public functions ----------------------------------------------------------*/
 
@@ -36,6 +96,100 @@ void Motor_Init(void)
     HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_2);
     HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_3);
     HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_4);
+    pwm_period = __HAL_TIM_GET_AUTORELOAD(&htim1) + 1u;
+}
+
+/**
+  * @brief  运行时修改PWM频率与对齐方式
+  * @param  freq_hz PWM频率（Hz）
+  * @param  center  true = 中心对齐，false = 边沿对齐
+  * @retval 频率超出范围（周期计数不足 PWM_PERIOD_MIN）返回false
+  * @note   控制器输出保持 ±MOTOR_PWM_MAX 归一化，比较值按新周期换算，PID增益无需调整。
+  *         重配期间四路输出消隐并完成挂起的换向，下一个控制周期恢复占空比；
+  *         CMS 位只能在计数器停止时修改；DIR 在 CMS 清零后才可写，单独清除。
+  *         中心对齐时 RCR=1，更新事件每个PWM周期一次（下溢）。
+  */
+bool Motor_SetPwmConfig(uint32_t freq_hz, bool center)
+{
+    TIM_TypeDef* tim = htim1.Instance;
+    uint32_t ticks, psc, arr, primask;
+
+    if (freq_hz == 0u) {
+        return false;
+    }
+    ticks = Get_Tim1_Clock() / freq_hz;
+    if (center) {
+        ticks /= 2u;  // 中心对齐：一个PWM周期计数 2·ARR
+    }
+    psc = ticks / 65536u;
+    ticks /= (psc + 1u);
+    if (ticks < PWM_PERIOD_MIN || psc > 0xFFFFu) {
+        return false;
+    }
+    arr = center ? ticks : ticks - 1u;
+
+    primask = __get_PRIMASK();
+    __disable_irq();  // 电流环可能在ADC中断中写同一组寄存器
+
+    /* 1. 立即消隐：比较值清零并产生更新事件，影子寄存器生效、计数器复位 */
+    for (int i = 0; i < 4; i++) {
+        __HAL_TIM_SetCompare(&htim1, motor_hw[i].pwm_channel, 0);
+    }
+    tim->EGR = TIM_EGR_UG;
+    tim->CR1 &= ~TIM_CR1_CEN;
+
+    /* 2. 输出已为低，直接完成挂起的换向 */
+    __HAL_TIM_DISABLE_IT(&htim1, TIM_IT_UPDATE);
+    for (int i = 0; i < 4; i++) {
+        if (bridges[i].pending != SWITCH_IDLE) {
+            Write_Bridge((MotorChannel)i, bridges[i].pending_state);
+            bridges[i].state = bridges[i].pending_state;
+            bridges[i].pending = SWITCH_IDLE;
+        }
+    }
+
+    /* 3. 写入新的对齐方式、分频与周期；
+     *    中心对齐时 DIR 只读并随计数翻转，切回边沿对齐后须清零，否则变成向下计数 */
+    tim->CR1 = (tim->CR1 & ~TIM_CR1_CMS) | (center ? TIM_CR1_CMS_0 : 0u);
+    if (!center) {
+        tim->CR1 &= ~TIM_CR1_DIR;
+    }
+    tim->PSC = psc;
+    tim->ARR = arr;
+    tim->RCR = 0;
+    tim->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+    htim1.Init.Prescaler = psc;
+    htim1.Init.Period = arr;
+    htim1.Init.CounterMode = center ? TIM_COUNTERMODE_CENTERALIGNED1 : TIM_COUNTERMODE_UP;
+    pwm_period = center ? arr : arr + 1u;
+    tim->CR1 |= TIM_CR1_CEN;
+    if (center) {
+        // 计数器启动后再写 RCR=1：更新事件（ADC注入触发、比较值装载）只发生在下溢，
+        // 即导通脉冲中点
+        tim->RCR = 1;
+    }
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/**
+  * @brief  当前PWM频率（Hz）
+  */
+uint32_t Motor_GetPwmFreq(void)
+{
+    TIM_TypeDef* tim = htim1.Instance;
+    uint32_t ticks = Motor_IsCenterAligned() ? 2u * tim->ARR : tim->ARR + 1u;
+
+    return Get_Tim1_Clock() / ((tim->PSC + 1u) * ticks);
+}
+
+/**
+  * @brief  是否为中心对齐（更新事件位于导通脉冲中点，电流采样须使用此模式）
+  */
+bool Motor_IsCenterAligned(void)
+{
+    return (htim1.Instance->CR1 & TIM_CR1_CMS) != 0u;
 }
 
 /**
@@ -47,10 +201,100 @@ void Motor_Init(void)
   */
 void Motor_OutPut(int speedA, int speedB, int speedC, int speedD)
 {
-    Set_Single_Motor(MOTOR_CHANNEL_A, speedA);
-    Set_Single_Motor(MOTOR_CHANNEL_B, speedB);
-    Set_Single_Motor(MOTOR_CHANNEL_C, speedC);
-    Set_Single_Motor(MOTOR_CHANNEL_D, speedD);
+    int speeds[4] = { speedA, speedB, speedC, speedD };
+
+    for (int i = 0; i < 4; i++) {
+        if (!fast_owned[i]) {
+            Set_Single_Motor((MotorChannel)i, speeds[i]);
+        }
+    }
+}
+
+/**
+  * @brief  设置单路电机输出（供电流环在ADC中断中调用）
+  * @param  channel 电机通道标识
+  * @param  speed   占空比（-MOTOR_PWM_MAX ~ +MOTOR_PWM_MAX）
+  */
+void Motor_OutPutSingle(MotorChannel channel, int speed)
+{
+    Set_Single_Motor(channel, speed);
+}
+
+/**
+  * @brief  切换通道的驱动来源
+  * @param  enable true = 由电流环 Motor_OutPutSingle() 驱动，Motor_OutPut() 不再写该通道
+  */
+void Motor_SetFastLoop(MotorChannel channel, bool enable)
+{
+    if (channel <= MOTOR_CHANNEL_D) {
+        fast_owned[channel] = enable;
+    }
+}
+
+/**
+  * @brief  设置零指令是否保持原方向
+  * @param  hold true = 零指令只把占空比置0，桥臂保持正转/反转，不触发制动、滑行或换向消隐；
+  *              false = 零指令按驱动模式制动或滑行
+  * @note   供Σ-Δ抖动使用：小占空比被抖动成 0/±1 交替时，0 不是真正的停止指令
+  */
+void Motor_SetZeroHold(MotorChannel channel, bool hold)
+{
+    if (channel <= MOTOR_CHANNEL_D) {
+        zero_hold[channel] = hold;
+    }
+}
+
+/**
+  * @brief  设置单路电机驱动模式
+  * @param  channel 电机通道标识
+  * @param  mode    驱动模式
+  * @retval 通道无效或当前接线不支持该模式时返回false
+  * @note   IN1/IN2 接普通GPIO、PWM 接使能端，PWM关断期的衰减方式由驱动芯片决定
+  *         （TB6612 类为短接制动/慢衰减，L298 类为续流/快衰减），软件只能选择
+  *         零指令时的状态；锁定反相需要 IN1/IN2 接互补定时器输出，本板不支持。
+  */
+bool Motor_SetDriveMode(MotorChannel channel, MotorDriveMode mode)
+{
+    if (channel > MOTOR_CHANNEL_D || mode >= MOTOR_DRIVE_LOCKED_ANTIPHASE) {
+        return false;
+    }
+    drive_modes[channel] = mode;
+    return true;
+}
+
+/**
+  * @brief  TIM1更新中断处理：推进挂起的换向
+  * @note   在 TIM1_UP_IRQHandler 中调用。每个通道分两步：
+  *         - ARMED → READY：写0之后的第一个更新事件，比较值0装载生效
+  *           （该次中断也可能来自写0之前已挂起的更新标志，此时不能换向）
+  *         - READY：本周期比较值必为0（输出全低），原子切换IN1/IN2，
+  *           新占空比经预装载在下一周期生效
+  *         即换向前后至少有一个完整PWM周期的消隐，与各通道写0的先后及调用来源无关。
+  */
+void Motor_PwmUpdate_IRQHandler(void)
+{
+    bool busy = false;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();  // 电流环（ADC中断）可能抢占并挂起新的换向
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+
+    for (int i = 0; i < 4; i++) {
+        MotorBridge* bridge = &bridges[i];
+        if (bridge->pending == SWITCH_READY) {
+            Write_Bridge((MotorChannel)i, bridge->pending_state);
+            __HAL_TIM_SetCompare(&htim1, motor_hw[i].pwm_channel, bridge->pending_duty);  // 已换算为比较值
+            bridge->state = bridge->pending_state;
+            bridge->pending = SWITCH_IDLE;
+        } else if (bridge->pending == SWITCH_ARMED) {
+            bridge->pending = SWITCH_READY;
+            busy = true;
+        }
+    }
+    if (!busy) {
+        __HAL_TIM_DISABLE_IT(&htim1, TIM_IT_UPDATE);
+    }
+    __set_PRIMASK(primask);
 }
 
 /* Private functions --------------------------------------------------------*/
@@ -59,57 +303,101 @@ void Motor_OutPut(int speedA, int speedB, int speedC, int speedD)
   * @brief  设置单个电机输出（内部使用）
   * @param  channel 电机通道标识
   * @param  speed   目标速度（带方向）
+  * @note   桥臂状态不变时只更新占空比；需要改变IN1/IN2时先将占空比置0，
+  *         由TIM1更新中断确认0已装载后，在消隐周期内换向并恢复占空比（见 Motor_PwmUpdate_IRQHandler）。
+  *         控制周期（TIM6）与电流环（ADC中断）都会调用，桥臂状态的读写在临界区内完成。
   */
 static void Set_Single_Motor(MotorChannel channel, int speed)
 {
-    GPIO_PinState pin1_state, pin2_state;
-    uint32_t pwm_channel;
-    GPIO_TypeDef* in1_port, *in2_port;
-    uint16_t in1_pin, in2_pin;
-
-    /* 根据通道选择对应GPIO和TIM通道 */
-    switch (channel) {
-        case MOTOR_CHANNEL_A:
-            in1_port = AIN1_GPIO_Port; in1_pin = AIN1_Pin;
-            in2_port = AIN2_GPIO_Port; in2_pin = AIN2_Pin;
-            pwm_channel = TIM_CHANNEL_1;
-            break;
-        case MOTOR_CHANNEL_B:
-            in1_port = BIN1_GPIO_Port; in1_pin = BIN1_Pin;
-            in2_port = BIN2_GPIO_Port; in2_pin = BIN2_Pin;
-            pwm_channel = TIM_CHANNEL_2;
-            break;
-        case MOTOR_CHANNEL_C:
-            in1_port = CIN1_GPIO_Port; in1_pin = CIN1_Pin;
-            in2_port = CIN2_GPIO_Port; in2_pin = CIN2_Pin;
-            pwm_channel = TIM_CHANNEL_3;
-            break;
-        case MOTOR_CHANNEL_D:
-            in1_port = DIN1_GPIO_Port; in1_pin = DIN1_Pin;
-            in2_port = DIN2_GPIO_Port; in2_pin = DIN2_Pin;
-            pwm_channel = TIM_CHANNEL_4;
-            break;
-        default:
-            return;
+    const MotorHw* hw;
+    MotorBridge* bridge;
+    BridgeState state;
+    uint32_t duty, primask;
+
+    if (channel > MOTOR_CHANNEL_D) {
+        return;
     }
+    hw = &motor_hw[channel];
+    bridge = &bridges[channel];
 
     /* 速度限幅 */
     speed = (speed > MOTOR_PWM_MAX) ? MOTOR_PWM_MAX :
             (speed < -MOTOR_PWM_MAX) ? -MOTOR_PWM_MAX : speed;
 
-    /* 设置方向控制引脚 */
-    if (speed >= 0) {
-        pin1_state = GPIO_PIN_SET;
-        pin2_state = GPIO_PIN_RESET;
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    /* 目标桥臂状态与占空比：零指令时保持原方向，或制动/滑行 */
+    if (speed > 0) {
+        state = BRIDGE_FORWARD;
+        duty = (uint32_t)speed;
+    } else if (speed < 0) {
+        state = BRIDGE_REVERSE;
+        duty = (uint32_t)(-speed);
     } else {
-        pin1_state = GPIO_PIN_RESET;
-        pin2_state = GPIO_PIN_SET;
-        speed = -speed;  // 转换为正数
+        state = (bridge->pending != SWITCH_IDLE) ? bridge->pending_state : bridge->state;
+        duty = 0;
+        if (!zero_hold[channel] || (state != BRIDGE_FORWARD && state != BRIDGE_REVERSE)) {
+            if (drive_modes[channel] == MOTOR_DRIVE_BRAKE) {
+                state = BRIDGE_BRAKE;
+                duty = MOTOR_PWM_MAX;
+            } else {
+                state = BRIDGE_COAST;
+            }
+        }
     }
+    duty = Duty_To_Compare(duty);
 
-    HAL_GPIO_WritePin(in1_port, in1_pin, pin1_state);
-    HAL_GPIO_WritePin(in2_port, in2_pin, pin2_state);
-            __HAL_TIM_SetCompare(&htim1, pwm_channel, (uint32_t)speed);
+    if (bridge->pending != SWITCH_IDLE) {
+        /* 换向进行中：只更新换向后的目标 */
+        bridge->pending_state = state;
+        bridge->pending_duty = duty;
+    } else if (state == bridge->state) {
+        __HAL_TIM_SetCompare(&htim1, hw->pwm_channel, duty);
+    } else {
+        /* 需要换向：先消隐，等待下一个更新事件 */
+        __HAL_TIM_SetCompare(&htim1, hw->pwm_channel, 0);
+        bridge->pending_state = state;
+        bridge->pending_duty = duty;
+        bridge->pending = SWITCH_ARMED;
+        __HAL_TIM_ENABLE_IT(&htim1, TIM_IT_UPDATE);
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  TIM1计数时钟（APB2分频不为1时定时器时钟加倍）
+  */
+static uint32_t Get_Tim1_Clock(void)
+{
+    uint32_t clk = HAL_RCC_GetPCLK2Freq();
+
+    if ((RCC->CFGR & RCC_CFGR_PPRE2) != RCC_CFGR_PPRE2_DIV1) {
+        clk *= 2u;
+    }
+    return clk;
+}
+
+/**
+  * @brief  一次BSRR写入同时切换IN1/IN2，不出现中间状态
+  */
+static void Write_Bridge(MotorChannel channel, BridgeState state)
+{
+    const MotorHw* hw = &motor_hw[channel];
+    uint32_t set = 0, reset = 0;
+
+    if (state == BRIDGE_FORWARD || state == BRIDGE_BRAKE) {
+        set |= hw->in1_pin;
+    } else {
+        reset |= hw->in1_pin;
+    }
+    if (state == BRIDGE_REVERSE || state == BRIDGE_BRAKE) {
+        set |= hw->in2_pin;
+    } else {
+        reset |= hw->in2_pin;
+    }
+    hw->port->BSRR = set | (reset << 16);
 }
 
 /************************ (C) COPYRIGHT [公司/作者] *****END OF FILE****/
\ No newline at end of file
@@ -13,6 +13,7 @@ extern "C" {
 #endif
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
 #include "stm32f1xx_hal.h"
 
 /* Type definitions ----------------------------------------------------------*/
@@ -23,9 +24,23 @@ typedef enum {
     MOTOR_CHANNEL_D       // 电机D
 } MotorChannel;
 
+typedef enum {
+    MOTOR_DRIVE_BRAKE = 0,          // 零指令时主动制动（IN1=IN2=高）
+    MOTOR_DRIVE_COAST,              // 零指令时滑行（IN1=IN2=低，桥臂高阻）
+    MOTOR_DRIVE_LOCKED_ANTIPHASE    // 锁定反相（需IN引脚接定时器输出，本板不支持）
+} MotorDriveMode;
+
 /* Function prototypes ------------------------------------------------------*/
 void Motor_Init(void);
 void Motor_OutPut(int speedA, int speedB, int speedC, int speedD);
+bool Motor_SetDriveMode(MotorChannel channel, MotorDriveMode mode);
+void Motor_PwmUpdate_IRQHandler(void);
+bool Motor_SetPwmConfig(uint32_t freq_hz, bool center);
+uint32_t Motor_GetPwmFreq(void);
+bool Motor_IsCenterAligned(void);
+void Motor_OutPutSingle(MotorChannel channel, int speed);
+void Motor_SetFastLoop(MotorChannel channel, bool enable);
+void Motor_SetZeroHold(MotorChannel channel, bool hold);
 
 #ifdef __cplusplus
 }
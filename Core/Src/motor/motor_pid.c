@@ -3,6 +3,23 @@
 #include "ax_encoder.h"
 #include "tim.h"
 #include "F:\Project\DSB1\Core\Src\motor_frame\uart2_motor_frame.h"
+#include "motor_pid.h"
+#include "motor_pos.h"
+#include "motor_sync.h"
+#include "../speed_ramp/speed_ramp.h"
+#include "../autotune/autotune.h"
+#include "../motor_cal/motor_cal.h"
+#include "../current_loop/current_loop.h"
+#include "../vbus_comp/vbus_comp.h"
+#include "../motor_protect/motor_protect.h"
+#include "../motor_slip/motor_slip.h"
+#include "../adc_sense/adc_sense.h"
+#include "../speed_est/speed_est.h"
+#include "../motor_dob/motor_dob.h"
+#include "../sysid/sysid.h"
+#include "../bode/bode.h"
+#include "../motor_filter/motor_filter.h"
+#include "../motor_ilc/motor_ilc.h"
 /**
  * @file motor_pid.c
  * @brief 四电机PID速度控制器（全整型实现）
@@ -15,24 +32,25 @@
 
 // PID 参数和限幅配置
 #define INTEGRAL_LIMIT   100000   ///< 积分限幅值（放大100倍存储）
-#define OUTPUT_LIMIT     1000     ///< PWM输出限幅值（±1000）
-
-/**
- * @brief 电机标识枚举
- */
-typedef enum {
-    MOTOR_A,  ///< 电机A（如左前轮）
-    MOTOR_B,  ///< 电机B（如右前轮）
-    MOTOR_C,  ///< 电机C（如左后轮）
-    MOTOR_D   ///< 电机D（如右后轮）
-} MotorID;
+#define DITHER_ZERO_TICKS PWM_FINE_SCALE   ///< 连续0占空比超过该周期数视为真正的零指令
+#define DESAT_RAW_LIMIT  (OUTPUT_LIMIT_FINE * 4)  ///< 去饱和前单轴输出上限（Q6，防溢出）
 
 /**
  * @brief PID状态结构体（全整型）
  */
 typedef struct {
     int integral;      ///< 积分项（实际值 = integral / 100）
-    int prev_error;    ///< 上一次速度误差
+    int integ_frac;    ///< 积分的小数余量（Q8，0~255），分数反馈的误差不丢失
+    int bias;          ///< 积分之外的常值项（×100）：Ki = 0 时保存原积分贡献，否则为重平衡余数
+    int aw_rem;        ///< 反算抗饱和除法余数（跨周期累计，小幅饱和也能回退积分）
+    int prev_error;    ///< 上一次速度误差（Q8）
+    int prev_meas;     ///< 上一次实际速度（Q8，测量微分用）
+    int p_error;       ///< 上一次比例项误差 β·r - y（×100）
+    int d_filt;        ///< 滤波后的微分（Q8）
+    int raw_output;    ///< 上一次限幅前输出（PWM，Q6）
+    int applied;       ///< 上一次实际施加的输出（PWM，Q6，PID_TrackOutput写入）
+    int aw_excess;     ///< 实际输出 - 限幅前输出（Q6），用于积分反算
+    bool bumpless;     ///< 下一周期执行无扰切换（重建积分）
 } PID_State;
 
 /**
@@ -43,22 +61,80 @@ typedef struct {
     int Kp;           ///< 比例系数（实际值 = Kp / 100）
     int Ki;           ///< 积分系数（实际值 = Ki / 100）
     int Kd;           ///< 微分系数（实际值 = Kd / 100）
+    int kV;           ///< 速度前馈（PWM / (计数/ms)，实际值 = kV / 100）
+    int kA;           ///< 加速度前馈（PWM / (计数/ms/s)，实际值 = kA / 100）
+    int kS;           ///< 静摩擦补偿（PWM，实际值 = kS / 100）
+    int Kaw;          ///< 抗饱和反算系数（每周期消除超出量的 Kaw%，0=关闭）
+    int beta;         ///< 比例项目标权重 β（×100，100 = 标准PID）
+    int d_alpha;      ///< 微分一阶IIR系数（1~256，256 = 不滤波）
+    bool d_on_meas;   ///< 微分作用于测量值（true）或误差（false）
 } PID_Params;
 
+#define PID_PARAMS_DEFAULT { \
+        .Kp = 5500,  /* 实际值 = 55.00 */ \
+        .Ki = 800,   /* 实际值 = 8.00  */ \
+        .Kd = 0,                          \
+        .kV = 0,     /* 前馈默认关闭   */ \
+        .kA = 0,                          \
+        .kS = 0,                          \
+        .Kaw = 30,   /* 约 Ti 量级的跟踪时间 */ \
+        .beta = 100,                      \
+        .d_alpha = 64, /* 截止约 50Hz @1kHz */ \
+        .d_on_meas = true                 \
+}
+
 // 全局变量
 static PID_State motor_states[4];  ///< 四个电机的PID状态
-static PID_Params pid_params = {   ///< 统一PID参数（可改为数组实现独立参数）
-        .Kp = 5500,  // 实际值 = 60.00
-        .Ki = 800,   // 实际值 = 5.00
-        .Kd = 00    // 实际值 = 2.00
+static PID_Params pid_params[4] = { ///< 各电机独立PID参数
+        PID_PARAMS_DEFAULT, PID_PARAMS_DEFAULT,
+        PID_PARAMS_DEFAULT, PID_PARAMS_DEFAULT
 };
 
 int target_speeds[4];  ///< 四个电机的目标速度（单位：编码器计数值）
 int real_speeds[4];    ///< 四个电机的实际速度（需由编码器读取）
 int pwm_outputs[4];    ///< 四个电机的PWM输出值（±OUTPUT_LIMIT）
+static int pwm_fine[4];      ///< 去饱和后的精细输出（Q6，±OUTPUT_LIMIT_FINE）
+static int dither_resid[4];  ///< Σ-Δ 抖动残差（Q6）
+static uint8_t dither_zero_ticks[4];  ///< 连续输出0占空比的周期数
+volatile uint16_t motor_status[4];  ///< 各电机状态标志（MOTOR_FLAG_*）
+static bool desat_enabled = true;   ///< 四轴协调去饱和开关
+static CycleMeter pid_meter;        ///< 速度环执行时间统计
 
 /* 私有函数声明 */
-static int PID_Control(MotorID id, int setpoint, int real_speed);
+static int PID_Control(MotorID id, int setpoint, int accel, int meas_q8);
+static int PID_ControlFiltered(MotorID id, int setpoint, int accel, int feedback);
+static void Desaturate_Outputs(int outputs[4]);
+static int Dither_Output(MotorID id, int fine);
+
+/**
+ * @brief 该轴输出是否由自整定/标定/系统辨识/扫频接管（不参与同步、去饱和与保护限幅）
+ */
+static inline bool Axis_Overridden(MotorID id) {
+    return Autotune_IsActive(id) || MotorCal_IsActive(id) || Sysid_IsActive(id) || Bode_IsActive(id);
+}
+
+/**
+ * @brief P、D 两项的合计贡献（×100），积分重平衡时使用
+ */
+static inline int PID_PDSum(const PID_Params *params, const PID_State *state) {
+    return (int)(((int64_t)params->Kp * state->p_error) / 100 +
+                 (((int64_t)params->Kd * state->d_filt) >> 8));
+}
+
+/**
+ * @brief 按目标积分贡献（×100）重建积分与常值项
+ * @note Ki ≠ 0：integral = 贡献 / Ki，除不尽的余数留在 bias；
+ *       Ki = 0：积分清零，贡献整体保存在 bias，改为 Ki = 0 时输出同样不跳变
+ */
+static void PID_Rebalance(const PID_Params *params, PID_State *state, int contrib) {
+    if (params->Ki != 0) {
+        state->integral = contrib / params->Ki;
+        state->bias = contrib - params->Ki * state->integral;
+    } else {
+        state->integral = 0;
+        state->bias = contrib;
+    }
+}
 
 /**
  * @brief 初始化PID控制器
@@ -68,96 +144,493 @@ void PID_Init(void) {
     HAL_TIM_Base_Start_IT(&htim6);  // 启动TIM6中断
     for (int i = 0; i < 4; i++) {
         motor_states[i].integral = 0;
+        motor_states[i].integ_frac = 0;
+        motor_states[i].bias = 0;
+        motor_states[i].aw_rem = 0;
         motor_states[i].prev_error = 0;
+        motor_states[i].prev_meas = 0;
+        motor_states[i].p_error = 0;
+        motor_states[i].d_filt = 0;
+        motor_states[i].raw_output = 0;
+        motor_states[i].applied = 0;
+        motor_states[i].aw_excess = 0;
+        motor_states[i].bumpless = false;
         target_speeds[i] = 0;
         real_speeds[i] = 0;
         pwm_outputs[i] = 0;
+        pwm_fine[i] = 0;
+        dither_resid[i] = 0;
+        dither_zero_ticks[i] = 0;
+        motor_status[i] = 0;
     }
+    MotorPos_Init();
+    MotorSync_Init();
+    MotorCal_Init();
+    VbusComp_Init();
+    MotorProtect_Init();
+    MotorSlip_Init();
+    SpeedEst_Init();
+    MotorDob_Init();
+    Sysid_Init();
+    Bode_Init();
+    MotorFilter_Init();
+    MotorIlc_Init();
 }
 
 /**
  * @brief PID控制计算（单电机）
  * @param id 电机标识（MOTOR_A~MOTOR_D）
  * @param setpoint 目标速度
- * @param real_speed 实际速度（需与目标速度同单位）
- * @return PWM输出值（±OUTPUT_LIMIT）
- * @note 计算过程全整型，公式：output = (Kp*e + Ki*∫e + Kd*Δe)/100
+ * @param accel 目标加速度（计数/ms/s，来自速度斜坡，无则为0）
+ * @param meas_q8 实际速度（与目标速度同单位，Q8）：估计器/窗口平均的小数部分直接参与计算，
+ *                避免四舍五入到整数后留下 ±0.5 的稳态偏差；原始增量反馈时小数为0，结果不变
+ * @return 限幅前的PWM输出（Q6，±DESAT_RAW_LIMIT，由 Update_Motors() 统一去饱和）
+ * @note 计算过程全整型，二自由度形式：
+ *       output = (Kp*(β·r - y) + Ki*∫(r - y) + Kd*D + kV*r + kA*a + kS*sign(r) + b + d̂)/100
+ *       D = IIR(-Δy)（测量微分）或 IIR(Δe)（误差微分），IIR 为 Q8 一阶低通
+ *       d̂ 为扰动观测器的负载估计（未启用时为0）
+ *       b 为参数切换时积分无法表示的余量（Ki=0 时即为原积分贡献），保证切换无跳变
+ *       抗饱和：积分额外累加 (实际输出-限幅前输出)·Kaw/Ki（反算法），
+ *       实际输出由 PID_TrackOutput() 在整条输出链路之后回写
  */
-static int PID_Control(MotorID id, int setpoint, int real_speed) {
+static int PID_Control(MotorID id, int setpoint, int accel, int meas_q8) {
     PID_State *state = &motor_states[id];
+    const PID_Params *params = &pid_params[id];
+
+    // 1. 计算误差（Q8）
+    int error = setpoint * 256 - meas_q8;
 
-    // 1. 计算误差
-    int error = setpoint - real_speed;
+    // 2. 比例项误差（目标加权 β，×100 保留精度）
+    int p_error = params->beta * setpoint - ((100 * meas_q8 + 128) >> 8);
 
-    // 2. 积分项计算（带限幅）
-    state->integral += error;
+    // 3. 微分项计算：测量微分不受目标阶跃冲击；一阶IIR滤除量化噪声
+    //    无扰切换周期不产生微分冲击
+    int d_raw = 0;
+    if (state->bumpless) {
+        state->d_filt = 0;
+    } else {
+        d_raw = params->d_on_meas ? state->prev_meas - meas_q8
+                                  : error - state->prev_error;
+    }
+    state->d_filt += ((d_raw - state->d_filt) * params->d_alpha) >> 8;
+    int d_term = (int)(((int64_t)params->Kd * state->d_filt) >> 8);
+    int p_term = (int)(((int64_t)params->Kp * p_error) / 100);
+
+    // 4. 前馈：速度、加速度、静摩擦（方向取目标速度符号），扰动观测器补偿
+    int sign = (setpoint > 0) - (setpoint < 0);
+    int feedforward = params->kV * setpoint +
+                      params->kA * accel +
+                      params->kS * sign;
+    feedforward += MotorDob_Update(id, state->applied, params->kV, params->kA, params->kS);
+
+    // 5. 积分项计算
+    if (state->bumpless) {
+        // 无扰切换：反推积分（Ki = 0 时为常值项），使本周期输出等于上周期实际输出
+        int applied_x100 = (int)(((int64_t)state->applied * 100) >> PWM_FRAC_BITS);
+        PID_Rebalance(params, state, applied_x100 - p_term - d_term - feedforward);
+        state->integ_frac = 0;
+        state->aw_rem = 0;
+    } else {
+        // 整数部分累加到积分，小数余量留到下一周期
+        int acc = error + state->integ_frac;
+        state->integral += acc >> 8;
+        state->integ_frac = acc & 0xFF;
+        if (params->Ki != 0) {
+            // 反算抗饱和：按实际限幅量回退积分，除法余数累计到下一周期
+            int64_t div = (int64_t)params->Ki * PWM_FINE_SCALE;
+            int64_t aw = (int64_t)state->aw_excess * params->Kaw + state->aw_rem;
+            int64_t q = aw / div;
+            state->integral += (int)q;
+            state->aw_rem = (int)(aw - q * div);
+        }
+    }
+    state->bumpless = false;
     if (state->integral > INTEGRAL_LIMIT) {
         state->integral = INTEGRAL_LIMIT;
     } else if (state->integral < -INTEGRAL_LIMIT) {
         state->integral = -INTEGRAL_LIMIT;
     }
 
-    // 3. 微分项计算
-    int derivative = error - state->prev_error;
+    // 6. PID公式计算（注意系数已放大100倍，输出保留6位小数供Σ-Δ抖动）
+    // output = [Kp*(β·r-y) + Ki*(∫e) + Kd*D + FF] * 64 / 100
+    int64_t sum = (int64_t)p_term +
+                  (int64_t)params->Ki * state->integral + state->bias +
+                  d_term +
+                  feedforward;
+    int output = (int)((sum * PWM_FINE_SCALE) / 100);
+    state->raw_output = output;
 
-    // 4. PID公式计算（注意系数已放大100倍）
-    // output = [Kp*e + Ki*(∫e) + Kd*(Δe)] / 100
-    int output = (pid_params.Kp * error +
-                  pid_params.Ki * state->integral +
-                  pid_params.Kd * derivative) / 100;
-
-    // 5. 输出限幅
-    if (output > OUTPUT_LIMIT) {
-        output = OUTPUT_LIMIT;
-    } else if (output < -OUTPUT_LIMIT) {
-        output = -OUTPUT_LIMIT;
+    // 7. 粗限幅（仅防止溢出，最终限幅在四轴去饱和中完成）
+    if (output > DESAT_RAW_LIMIT) {
+        output = DESAT_RAW_LIMIT;
+    } else if (output < -DESAT_RAW_LIMIT) {
+        output = -DESAT_RAW_LIMIT;
     }
 
-    // 6. 更新误差记录
+    // 8. 更新误差记录
     state->prev_error = error;
+    state->prev_meas = meas_q8;
+    state->p_error = p_error;
+
+    return output;
+}
 
+/**
+ * @brief PID计算后经输出滤波链（未启用时等同 PID_Control）
+ * @note 滤波后的值作为限幅前输出参与积分反算，滤波器自身的动态不会被当作饱和；
+ *       无扰切换时滤波器从上周期实际输出稳态起步
+ */
+static int PID_ControlFiltered(MotorID id, int setpoint, int accel, int feedback) {
+    PID_State *state = &motor_states[id];
+
+    if (!MotorFilter_IsActive(id, MOTOR_FILTER_OUTPUT)) {
+        return PID_Control(id, setpoint, accel, feedback);
+    }
+    if (state->bumpless) {
+        MotorFilter_Prime(id, MOTOR_FILTER_OUTPUT, state->applied);
+    }
+    int output = (int)MotorFilter_Process(id, MOTOR_FILTER_OUTPUT,
+                                          PID_Control(id, setpoint, accel, feedback));
+    state->raw_output = output;
+    if (output > DESAT_RAW_LIMIT) {
+        output = DESAT_RAW_LIMIT;
+    } else if (output < -DESAT_RAW_LIMIT) {
+        output = -DESAT_RAW_LIMIT;
+    }
     return output;
 }
 
+/**
+ * @brief 修改单个电机的PID/前馈参数
+ * @param id 电机标识（MOTOR_A~MOTOR_D）
+ * @param param 参数编号
+ * @param value 新值（放大100倍）
+ * @return 参数编号无效返回false
+ */
+bool PID_SetParam(MotorID id, PID_ParamID param, int value) {
+    PID_Params *params = &pid_params[id];
+    PID_State *state = &motor_states[id];
+
+    // 修改增益前记录 P+I+D 的合计贡献，修改后重平衡积分，保证输出不跳变
+    int pid_sum = PID_PDSum(params, state) + params->Ki * state->integral + state->bias;
+
+    switch (param) {
+        case PID_PARAM_KP: params->Kp = value; break;
+        case PID_PARAM_KI: params->Ki = value; break;
+        case PID_PARAM_KD: params->Kd = value; break;
+        case PID_PARAM_KV: params->kV = value; break;
+        case PID_PARAM_KA: params->kA = value; break;
+        case PID_PARAM_KS: params->kS = (value < 0) ? -value : value; break;
+        case PID_PARAM_KAW: params->Kaw = (value < 0) ? 0 : (value > 100) ? 100 : value; break;
+        case PID_PARAM_BETA: params->beta = (value < 0) ? 0 : (value > 100) ? 100 : value; break;
+        case PID_PARAM_D_ALPHA: params->d_alpha = (value < 1) ? 1 : (value > 256) ? 256 : value; break;
+        case PID_PARAM_D_ON_MEAS: params->d_on_meas = (value != 0); break;
+        default: return false;
+    }
+
+    if (param == PID_PARAM_KP || param == PID_PARAM_KI || param == PID_PARAM_KD) {
+        PID_Rebalance(params, state, pid_sum - PID_PDSum(params, state));
+        state->aw_rem = 0;
+    } else if (param == PID_PARAM_BETA || param == PID_PARAM_D_ON_MEAS) {
+        PID_Bumpless(id);  // 比例/微分项结构改变，按实际输出重建积分
+    }
+    return true;
+}
+
+/**
+ * @brief 请求无扰切换（运行模式或目标来源改变时调用）
+ * @note 下一控制周期按上周期实际输出反推积分，且不产生微分冲击
+ */
+void PID_Bumpless(MotorID id) {
+    motor_states[id].bumpless = true;
+}
+
+/**
+ * @brief 回写实际施加到电机的输出（整条输出链路限幅之后调用）
+ * @param id 电机标识
+ * @param applied 实际输出（PWM，Q6）
+ */
+void PID_TrackOutput(MotorID id, int applied) {
+    PID_State *state = &motor_states[id];
+
+    state->applied = applied;
+    state->aw_excess = state->bumpless ? 0 : applied - state->raw_output;
+}
+
 /**
  * @brief 更新四个电机的PID控制
  * @param target_speeds 目标速度数组（索引需对应MotorID）
  * @param real_speeds 实际速度数组（需提前通过编码器获取）
  * @param outputs PWM输出数组（用于驱动电机）
  * @note 应在控制周期固定调用（如1kHz定时器中断）
+ *       位置模式的轴忽略target_speeds，目标速度由位置外环给出；
+ *       速度模式的轴叠加交叉耦合同步修正（MotorSync_Update）
  */
 void Update_Motors(const int target_speeds[4], const int real_speeds[4], int outputs[4]) {
-    outputs[MOTOR_A] = PID_Control(MOTOR_A, target_speeds[MOTOR_A] + uart_angle_velocity[MOTOR_A], real_speeds[MOTOR_A]);
-    outputs[MOTOR_B] = PID_Control(MOTOR_B, target_speeds[MOTOR_B] + uart_angle_velocity[MOTOR_B], real_speeds[MOTOR_B]);
-    outputs[MOTOR_C] = PID_Control(MOTOR_C, target_speeds[MOTOR_C] + uart_angle_velocity[MOTOR_C], real_speeds[MOTOR_C]);
-    outputs[MOTOR_D] = PID_Control(MOTOR_D, target_speeds[MOTOR_D] + uart_angle_velocity[MOTOR_D], real_speeds[MOTOR_D]);
+    int setpoints[4];
+    int accels[4];
+    bool sync_eligible[4];
+    int sync_corr[4];
+    int applied[4];
+    bool closed_loop[4];
+
+    // 1. 各轴速度目标
+    for (int i = 0; i < 4; i++) {
+        accels[i] = 0;
+        if (MotorPos_IsActive((MotorID)i)) {
+            // 位置模式：位置外环输出作为速度目标
+            setpoints[i] = MotorPos_Update((MotorID)i, GetEncoder_Count((EncoderMotorID)i));
+        } else {
+            setpoints[i] = target_speeds[i] + uart_angle_velocity[i];
+            accels[i] = SpeedRamp_GetAccel((uint8_t)i);
+        }
+        sync_eligible[i] = !MotorPos_IsActive((MotorID)i) && !Axis_Overridden((MotorID)i);
+    }
+
+    // 2. 交叉耦合同步修正（速度模式的轴之间）
+    MotorSync_Update(setpoints, real_speeds, sync_eligible, sync_corr);
+
+    // 3. 速度环
+    for (int i = 0; i < 4; i++) {
+        int setpoint = setpoints[i] + sync_corr[i];
+        int feedback = (int)MotorFilter_Process((MotorID)i, MOTOR_FILTER_FEEDBACK,
+                                                SpeedEst_Feedback((MotorID)i, real_speeds[i]));  // Q8
+
+        if (Sysid_IsActive((MotorID)i)) {
+            // 系统辨识：开环时PID状态冻结；闭环时PID照常运行，激励计入 raw_output 不触发抗饱和
+            int pid_out = 0;
+            if (Sysid_IsClosedLoop()) {
+                pid_out = PID_ControlFiltered((MotorID)i, setpoint, accels[i], feedback);
+            }
+            outputs[i] = Sysid_Update((MotorID)i, pid_out);
+            motor_states[i].raw_output = outputs[i];
+            continue;
+        }
+        if (Bode_IsActive((MotorID)i)) {
+            // 频率响应：PLANT 开环、PID冻结；LOOP 激励叠加在输出上，不触发抗饱和；
+            // TRACK 激励叠加在目标上，PID照常运行
+            int pid_out = 0;
+            if (Bode_GetMode() != BODE_MODE_PLANT) {
+                pid_out = PID_ControlFiltered((MotorID)i, Bode_Reference((MotorID)i, setpoint),
+                                              accels[i], feedback);
+            }
+            outputs[i] = Bode_Update((MotorID)i, pid_out);
+            if (Bode_GetMode() != BODE_MODE_TRACK) {
+                motor_states[i].raw_output = outputs[i];
+            }
+            continue;
+        }
+        if (Autotune_IsActive((MotorID)i)) {
+            // 自整定期间由继电器输出接管，PID状态冻结
+            outputs[i] = Autotune_Update((MotorID)i, setpoint, real_speeds[i]) * PWM_FINE_SCALE;
+            motor_states[i].raw_output = outputs[i];
+            continue;
+        }
+        if (MotorCal_IsActive((MotorID)i)) {
+            // 标定期间开环扫描占空比，PID状态冻结
+            outputs[i] = MotorCal_Update((MotorID)i, real_speeds[i]) * PWM_FINE_SCALE;
+            motor_states[i].raw_output = outputs[i];
+            continue;
+        }
+        if (sync_eligible[i]) {
+            // 速度模式：叠加迭代学习修正（目标或前馈），前馈部分计入限幅前输出
+            int pid_out = PID_ControlFiltered((MotorID)i, MotorIlc_Setpoint((MotorID)i, setpoint),
+                                              accels[i], feedback);
+            outputs[i] = MotorIlc_Output((MotorID)i, pid_out);
+            motor_states[i].raw_output += outputs[i] - pid_out;
+            continue;
+        }
+        outputs[i] = PID_ControlFiltered((MotorID)i, setpoint, accels[i], feedback);
+    }
+
+    // 4. 堵转检测与热降额，得到各轴输出限幅
+    for (int i = 0; i < 4; i++) {
+        setpoints[i] += sync_corr[i];
+        applied[i] = motor_states[i].applied;
+        closed_loop[i] = !Axis_Overridden((MotorID)i);
+        // 被接管的轴（开环输出）以输出方向代替目标速度：输出归零或反向时解除堵转
+        MotorProtect_Update((MotorID)i, outputs[i], closed_loop[i] ? setpoints[i] : outputs[i],
+                            real_speeds[i]);
+    }
+
+    // 5. 迭代学习：记录本周期跟踪误差，更新下一试次的修正
+    MotorIlc_Update(setpoints, real_speeds, sync_eligible);
+
+    // 6. 打滑检测（四轮运动学一致性），得到牵引力限幅
+    MotorSlip_Update(setpoints, real_speeds, applied, closed_loop);
+
+    // 7. 四轴协调去饱和
+    Desaturate_Outputs(outputs);
+}
+
+/**
+ * @brief 四轴协调去饱和
+ * @param outputs 各轴限幅前输出（Q6），原地改写为最终输出（不超过各轴限幅）
+ * @note 各轴限幅取 MotorProtect_GetLimit() 与 MotorSlip_GetLimit() 的较小值
+ *       （正常为 OUTPUT_LIMIT_FINE，堵转/过热/打滑时降低）。
+ *       任一轴超限时按 min(限幅 / |u|) 等比例缩小所有参与的轴，
+ *       保持各轮输出比例（即底盘运动方向）不变，整车沿原路径减速；
+ *       自整定/标定/辨识/扫频中的轴不参与缩放，但仍按各自限幅钳位
+ *       （开环扫描时堵转、过热同样需要保护）。关闭时各轴独立限幅。
+ *       被缩放/限幅的轴置位 MOTOR_FLAG_SATURATED，
+ *       积分由 PID_TrackOutput() 按实际输出反算，不会继续累积。
+ */
+static void Desaturate_Outputs(int outputs[4]) {
+    int64_t num = 1;  // 缩放比例 num / den，初始为 1
+    int64_t den = 1;
+    int limits[4];
+
+    for (int i = 0; i < 4; i++) {
+        motor_status[i] &= (uint16_t)~MOTOR_FLAG_SATURATED;
+        limits[i] = MotorProtect_GetLimit((MotorID)i);
+        if (MotorSlip_GetLimit((MotorID)i) < limits[i]) {
+            limits[i] = MotorSlip_GetLimit((MotorID)i);
+        }
+        if (Axis_Overridden((MotorID)i)) {
+            continue;
+        }
+        int mag = (outputs[i] < 0) ? -outputs[i] : outputs[i];
+        if (mag > limits[i] && (int64_t)limits[i] * den < num * mag) {
+            num = limits[i];
+            den = mag;
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        if (desat_enabled && num < den && !Axis_Overridden((MotorID)i)) {
+            outputs[i] = (int)(((int64_t)outputs[i] * num) / den);
+            motor_status[i] |= MOTOR_FLAG_SATURATED;
+        }
+        if (outputs[i] > limits[i]) {
+            outputs[i] = limits[i];
+            motor_status[i] |= MOTOR_FLAG_SATURATED;
+        } else if (outputs[i] < -limits[i]) {
+            outputs[i] = -limits[i];
+            motor_status[i] |= MOTOR_FLAG_SATURATED;
+        }
+    }
+}
+
+/**
+ * @brief 一阶Σ-Δ抖动：把Q6精细输出转为整数占空比
+ * @param fine 精细输出（Q6，±OUTPUT_LIMIT_FINE）
+ * @return 整数占空比（±OUTPUT_LIMIT）
+ * @note 每周期的取整误差累加到下一周期。占空比在每个1ms控制周期内恒定，
+ *       平均只发生在周期之间（1kHz），连续若干周期的平均占空比等于精细输出，
+ *       由电机机械时间常数平滑；PWM 频率不变。
+ *       |fine| ≥ 1 LSB（1/64 占空比）时至少每 64 个周期输出一次非零占空比，
+ *       其间的 0 只是抖动结果：通知驱动层保持原方向、占空比0，不进入制动/滑行，
+ *       也不触发换向消隐；精细输出为0或连续 DITHER_ZERO_TICKS 个周期为0才是真正的零指令
+ */
+static int Dither_Output(MotorID id, int fine) {
+    int acc = fine + dither_resid[id];
+    int duty = (acc + PWM_FINE_SCALE / 2) >> PWM_FRAC_BITS;
+
+    if (duty > OUTPUT_LIMIT) {
+        duty = OUTPUT_LIMIT;
+    } else if (duty < -OUTPUT_LIMIT) {
+        duty = -OUTPUT_LIMIT;
+    }
+    dither_resid[id] = acc - duty * PWM_FINE_SCALE;
+
+    if (duty != 0) {
+        dither_zero_ticks[id] = 0;
+    } else if (dither_zero_ticks[id] < DITHER_ZERO_TICKS) {
+        dither_zero_ticks[id]++;
+    }
+    Motor_SetZeroHold((MotorChannel)id, fine != 0 && dither_zero_ticks[id] < DITHER_ZERO_TICKS);
+    return duty;
+}
+
+/**
+ * @brief 开关四轴协调去饱和（默认开启）
+ */
+void PID_SetDesaturation(bool enable) {
+    desat_enabled = enable;
+}
+
+CycleMeter *PID_GetMeter(void) {
+    return &pid_meter;
 }
 
 /**
  * @brief 电机速度PID控制任务
  * @note 需在定时器中断中周期性调用（如1kHz）
  * 执行流程：
- * 1. 读取编码器值 -> real_speeds[]
- * 2. 计算PID输出 -> pwm_outputs[]
- * 3. 输出PWM到电机
+ * 1. 读取编码器值（剔除异常增量）-> real_speeds[]，更新速度估计器，检测编码器断线
+ * 2. 计算PID输出（含反馈/输出滤波链）-> pwm_fine[]（Q6）
+ * 3. 死区/非线性补偿，母线电压前馈补偿，回写实际输出，驱动积分抗饱和
+ * 4. Σ-Δ抖动取整 -> pwm_outputs[]，输出PWM到电机
+ *    （启用电流环的轴改为更新电流目标，由电流环输出PWM）
  */
 void Motor_Speed_PID_Control(void) {
+    CycleMeter_Begin(&pid_meter);
+
     // 1. 读取实际速度（需实现GetEncoder_X()函数）
     real_speeds[MOTOR_A] = GetEncoder_A();
     real_speeds[MOTOR_B] = GetEncoder_B();
     real_speeds[MOTOR_C] = GetEncoder_C();
     real_speeds[MOTOR_D] = GetEncoder_D();
+    for (int i = 0; i < 4; i++) {
+        SpeedEst_Update((MotorID)i, real_speeds[i]);
+        Encoder_CheckDisconnect((EncoderMotorID)i, pwm_outputs[i], AdcSense_GetCurrent((MotorID)i));
+        if (Encoder_IsFaulted((EncoderMotorID)i)) {
+            motor_status[i] |= MOTOR_FLAG_ENC_FAULT;
+        } else {
+            motor_status[i] &= (uint16_t)~MOTOR_FLAG_ENC_FAULT;
+        }
+    }
 
     // 2. 计算PID输出
-    Update_Motors(target_speeds, real_speeds, pwm_outputs);
+    Update_Motors(target_speeds, real_speeds, pwm_fine);
+    MotorFilter_EndTick();
+
+    // 3. 查表线性化，母线电压补偿，回写实际输出（积分反算抗饱和），Σ-Δ抖动取整
+    VbusComp_Update();
+    for (int i = 0; i < 4; i++) {
+        int duty = pwm_fine[i];
+
+        if (CurrentLoop_IsEnabled((MotorID)i)) {
+            // 电流环接管：输出作为电流目标，占空比由PWM周期中断计算
+            PID_TrackOutput((MotorID)i, duty);
+            CurrentLoop_SetRef((MotorID)i, duty);
+            Motor_SetZeroHold((MotorChannel)i, false);
+            pwm_outputs[i] = CurrentLoop_GetDuty((MotorID)i);  // 遥测与断线检测需要实际占空比
+            continue;
+        }
+        // 查找表按标定电压把线性域映射为占空比，死区与起转占空比也需按电压缩放，
+        // 因此先线性化再乘电压增益
+        bool cal = MotorCal_IsActive((MotorID)i);
+        if (!cal) {
+            duty = MotorCal_Linearize((MotorID)i, duty, real_speeds[i]);
+        }
+        duty = VbusComp_Apply(duty);
+        if (duty == OUTPUT_LIMIT_FINE || duty == -OUTPUT_LIMIT_FINE) {
+            // 补偿后限幅：最终占空比逐级逆换算回控制器域回写
+            int lin = VbusComp_Remove(duty);
+            PID_TrackOutput((MotorID)i, cal ? lin : MotorCal_Unlinearize((MotorID)i, lin));
+        } else {
+            PID_TrackOutput((MotorID)i, pwm_fine[i]);
+        }
+        pwm_outputs[i] = Dither_Output((MotorID)i, duty);
+    }
+    for (int i = 0; i < 4; i++) {
+        Sysid_Record((MotorID)i, pwm_fine[i], real_speeds[i]);
+        Bode_Record((MotorID)i, pwm_fine[i], real_speeds[i]);
+    }
+    MotorCal_Task();
+    Sysid_Task();
+    Bode_Task();
 
-    // 3. 驱动电机（需实现Motor_OutPut()函数）
+    // 4. 驱动电机（需实现Motor_OutPut()函数）
     Motor_OutPut(
             pwm_outputs[MOTOR_A],
             pwm_outputs[MOTOR_B],
             pwm_outputs[MOTOR_C],
             pwm_outputs[MOTOR_D]
     );
+
+    CycleMeter_End(&pid_meter);
 }
 
 /********************************
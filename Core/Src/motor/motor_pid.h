@@ -11,6 +11,8 @@
 #define __MOTOR_PID_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "../cycle_meter/cycle_meter.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,10 +26,44 @@ typedef enum {
     MOTOR_D   ///< 电机D（如右后轮）
 } MotorID;
 
+#define OUTPUT_LIMIT     1000     ///< PWM输出限幅值（±1000）
+#define PWM_FRAC_BITS    6        ///< 控制输出小数位数（Σ-Δ抖动前的精细输出为Q6）
+#define PWM_FINE_SCALE   (1 << PWM_FRAC_BITS)
+#define OUTPUT_LIMIT_FINE (OUTPUT_LIMIT * PWM_FINE_SCALE)  ///< Q6输出限幅值
+
+/* PID可调参数编号 ------------------------------------------------------*/
+typedef enum {
+    PID_PARAM_KP,  ///< 比例系数 Kp（×100）
+    PID_PARAM_KI,  ///< 积分系数 Ki（×100，每1ms周期）
+    PID_PARAM_KD,  ///< 微分系数 Kd（×100，每1ms周期）
+    PID_PARAM_KV,  ///< 速度前馈 kV（PWM/(计数/ms) × 100）
+    PID_PARAM_KA,  ///< 加速度前馈 kA（PWM/(计数/ms/s) × 100）
+    PID_PARAM_KS,  ///< 静摩擦补偿 kS（PWM × 100，按目标方向施加）
+    PID_PARAM_KAW,      ///< 抗饱和反算系数（0~100，每周期回退超出量的百分比）
+    PID_PARAM_BETA,     ///< 比例项目标权重 β（0~100，×100）
+    PID_PARAM_D_ON_MEAS,///< 微分来源（1 = 测量值，0 = 误差）
+    PID_PARAM_D_ALPHA   ///< 微分滤波系数（1~256，Q8，256 = 不滤波）
+} PID_ParamID;
+
+/* 电机状态标志（motor_status[]，随遥测上报） ----------------------------*/
+#define MOTOR_FLAG_POS_MODE      (1u << 0)  ///< 处于位置模式
+#define MOTOR_FLAG_POS_REACHED   (1u << 1)  ///< 位置到位
+#define MOTOR_FLAG_AUTOTUNE      (1u << 2)  ///< 继电器自整定进行中
+#define MOTOR_FLAG_SATURATED     (1u << 3)  ///< 输出饱和（已等比例缩放或限幅）
+#define MOTOR_FLAG_CALIBRATING   (1u << 4)  ///< 死区/非线性标定进行中
+#define MOTOR_FLAG_STALL         (1u << 5)  ///< 堵转（输出已降到堵转保持占空比）
+#define MOTOR_FLAG_DERATE        (1u << 6)  ///< 热模型降额中
+#define MOTOR_FLAG_SLIP          (1u << 7)  ///< 车轮打滑（违反运动学约束）
+#define MOTOR_FLAG_ENC_FAULT     (1u << 8)  ///< 编码器疑似断线
+#define MOTOR_FLAG_SYSID         (1u << 9)  ///< 系统辨识激励进行中
+#define MOTOR_FLAG_BODE          (1u << 10) ///< 频率响应扫频进行中
+#define MOTOR_FLAG_ILC           (1u << 11) ///< 迭代学习修正生效中
+
 /* 外部可访问变量 --------------------------------------------------------*/
 extern int target_speeds[4];  ///< 目标速度数组（索引对应MotorID）
 extern int pwm_outputs[4];    ///< PWM输出数组（±OUTPUT_LIMIT）
 extern int real_speeds[4];    ///< 四个电机的实际速度（需由编码器读取）
+extern volatile uint16_t motor_status[4];  ///< 各电机状态标志（MOTOR_FLAG_*）
 /* 函数声明 --------------------------------------------------------------*/
 
 /**
@@ -42,6 +78,40 @@ void PID_Init(void);
  */
 void Motor_Speed_PID_Control(void);
 
+/**
+ * @brief 修改单个电机的PID/前馈参数
+ * @param id 电机标识（MOTOR_A~MOTOR_D）
+ * @param param 参数编号
+ * @param value 新值（放大100倍）
+ * @return 参数编号无效返回false
+ * @note 修改Kp/Ki/Kd时重平衡积分，输出无跳变
+ */
+bool PID_SetParam(MotorID id, PID_ParamID param, int value);
+
+/**
+ * @brief 请求无扰切换（运行模式或目标来源改变时调用）
+ * @note 下一控制周期按上周期实际输出反推积分，且不产生微分冲击
+ */
+void PID_Bumpless(MotorID id);
+
+/**
+ * @brief 回写实际施加到电机的输出（整条输出链路限幅之后调用）
+ * @param id 电机标识
+ * @param applied 实际输出（PWM，Q6）
+ */
+void PID_TrackOutput(MotorID id, int applied);
+
+/**
+ * @brief 开关四轴协调去饱和（默认开启）
+ * @note 开启时任一轴超限则四轴等比例缩放，关闭时各轴独立限幅
+ */
+void PID_SetDesaturation(bool enable);
+
+/**
+ * @brief 速度环执行时间统计（Motor_Speed_PID_Control 全程）
+ */
+CycleMeter *PID_GetMeter(void);
+
 /**
  * @brief 设置单个电机目标速度
  * @param id 电机标识（MOTOR_A~MOTOR_D）
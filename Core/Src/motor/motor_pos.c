@@ -0,0 +1,145 @@
+/**
+ * @file motor_pos.c
+ * @brief 四电机位置外环（P控制 + 速度限幅 + 到位判定）
+ *
+ * 功能：
+ * 1. 每轴独立的位置/速度模式切换
+ * 2. 位置误差 × Kp 生成速度目标，限幅到 vmax
+ * 3. 速度指令的小数部分跨周期累加，低速时不因取整产生死区
+ * 4. 误差连续 POS_SETTLE_TICKS 个周期在 ±tolerance 内置位 MOTOR_FLAG_POS_REACHED
+ */
+
+#include "motor_pos.h"
+#include "ax_encoder.h"
+
+/**
+ * @brief 位置环状态（全整型）
+ */
+typedef struct {
+    MotorMode mode;     ///< 当前运行模式
+    int32_t target;     ///< 目标位置（编码器计数）
+    int32_t kp;         ///< 比例系数（实际值 = kp / 1000）
+    int32_t vmax;       ///< 速度限幅（计数/ms）
+    int32_t tolerance;  ///< 到位窗口（±计数）
+    int32_t remainder;  ///< 速度指令余数（单位 1/1000 计数/ms）
+    uint16_t settle;    ///< 连续在窗口内的周期数
+} PosAxis;
+
+static PosAxis pos_axes[4];
+
+/**
+ * @brief 初始化位置环（所有轴回到速度模式）
+ */
+void MotorPos_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        pos_axes[i].mode = MOTOR_MODE_VELOCITY;
+        pos_axes[i].target = 0;
+        pos_axes[i].kp = POS_KP_DEFAULT;
+        pos_axes[i].vmax = POS_VMAX_DEFAULT;
+        pos_axes[i].tolerance = POS_TOL_DEFAULT;
+        pos_axes[i].remainder = 0;
+        pos_axes[i].settle = 0;
+        motor_status[i] &= (uint16_t)~(MOTOR_FLAG_POS_MODE | MOTOR_FLAG_POS_REACHED);
+    }
+}
+
+/**
+ * @brief 切换运行模式
+ */
+void MotorPos_SetMode(MotorID id, MotorMode mode) {
+    PosAxis *axis = &pos_axes[id];
+
+    if (mode == MOTOR_MODE_POSITION) {
+        if (axis->mode != MOTOR_MODE_POSITION) {
+            axis->target = GetEncoder_Count((EncoderMotorID)id);  // 原地保持
+            axis->remainder = 0;
+            axis->settle = 0;
+        }
+        motor_status[id] |= MOTOR_FLAG_POS_MODE;
+    } else {
+        motor_status[id] &= (uint16_t)~(MOTOR_FLAG_POS_MODE | MOTOR_FLAG_POS_REACHED);
+    }
+    if (axis->mode != mode) {
+        PID_Bumpless(id);  // 目标来源改变，速度环无扰切换
+    }
+    axis->mode = mode;
+}
+
+bool MotorPos_IsActive(MotorID id) {
+    return pos_axes[id].mode == MOTOR_MODE_POSITION;
+}
+
+bool MotorPos_SetTarget(MotorID id, int32_t target) {
+    PosAxis *axis = &pos_axes[id];
+
+    if (axis->mode != MOTOR_MODE_POSITION) {
+        return false;
+    }
+    axis->target = target;
+    axis->settle = 0;
+    motor_status[id] &= (uint16_t)~MOTOR_FLAG_POS_REACHED;
+    return true;
+}
+
+bool MotorPos_Move(MotorID id, int32_t delta) {
+    return MotorPos_SetTarget(id, pos_axes[id].target + delta);
+}
+
+void MotorPos_SetKp(MotorID id, int32_t kp) {
+    pos_axes[id].kp = (kp < 0) ? 0 : kp;
+    pos_axes[id].remainder = 0;
+}
+
+void MotorPos_SetVelLimit(MotorID id, int32_t vmax) {
+    pos_axes[id].vmax = (vmax < 0) ? -vmax : vmax;
+}
+
+void MotorPos_SetTolerance(MotorID id, int32_t tol) {
+    pos_axes[id].tolerance = (tol < 0) ? -tol : tol;
+}
+
+/**
+ * @brief 位置外环计算
+ * @note 公式：v = clamp(Kp * (target - position) / 1000, ±vmax)
+ */
+int MotorPos_Update(MotorID id, int32_t position) {
+    PosAxis *axis = &pos_axes[id];
+    int32_t error = axis->target - position;
+
+    // 1. 到位判定
+    if (error <= axis->tolerance && error >= -axis->tolerance) {
+        if (axis->settle < POS_SETTLE_TICKS) {
+            axis->settle++;
+        } else {
+            motor_status[id] |= MOTOR_FLAG_POS_REACHED;
+        }
+    } else {
+        axis->settle = 0;
+        motor_status[id] &= (uint16_t)~MOTOR_FLAG_POS_REACHED;
+    }
+
+    // 2. P控制，余数保留到下一周期
+    int64_t acc = (int64_t)axis->kp * error + axis->remainder;
+    int64_t cmd = acc / 1000;
+    axis->remainder = (int32_t)(acc - cmd * 1000);
+
+    // 3. 速度限幅（限幅时丢弃余数）
+    if (cmd > axis->vmax) {
+        cmd = axis->vmax;
+        axis->remainder = 0;
+    } else if (cmd < -axis->vmax) {
+        cmd = -axis->vmax;
+        axis->remainder = 0;
+    }
+
+    return (int)cmd;
+}
+
+/**
+ * @brief 编码器清零前调用，目标随坐标系一起平移
+ */
+void MotorPos_Rebase(void) {
+    for (int i = 0; i < 4; i++) {
+        pos_axes[i].target -= GetEncoder_Count((EncoderMotorID)i);
+    }
+}
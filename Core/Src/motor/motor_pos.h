@@ -0,0 +1,81 @@
+/**
+ * @file motor_pos.h
+ * @brief 四电机位置外环（级联在速度PID之前）
+ *
+ * @note 位置环输出作为速度PID的目标值，在1kHz控制中断中运行；
+ *       位置单位为编码器原始计数（GetEncoder_Count），速度单位为计数/ms。
+ */
+
+#ifndef __MOTOR_POS_H
+#define __MOTOR_POS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 默认参数 --------------------------------------------------------------*/
+#define POS_KP_DEFAULT        20     ///< 位置环比例系数（实际值 = Kp / 1000）
+#define POS_VMAX_DEFAULT      30     ///< 速度限幅（计数/ms）
+#define POS_TOL_DEFAULT       20     ///< 到位判定窗口（±计数）
+#define POS_SETTLE_TICKS      20     ///< 连续处于窗口内的周期数才判定到位
+
+/**
+ * @brief 电机运行模式
+ */
+typedef enum {
+    MOTOR_MODE_VELOCITY = 0,  ///< 速度模式（目标来自UART速度帧）
+    MOTOR_MODE_POSITION       ///< 位置模式（目标来自位置外环）
+} MotorMode;
+
+/**
+ * @brief 初始化位置环（所有轴回到速度模式）
+ */
+void MotorPos_Init(void);
+
+/**
+ * @brief 切换运行模式
+ * @note 切入位置模式时以当前位置为目标（原地保持），之后再下发目标位置
+ */
+void MotorPos_SetMode(MotorID id, MotorMode mode);
+
+/**
+ * @brief 当前是否处于位置模式
+ */
+bool MotorPos_IsActive(MotorID id);
+
+/**
+ * @brief 设置绝对目标位置（仅位置模式下有效）
+ * @return 非位置模式返回false
+ */
+bool MotorPos_SetTarget(MotorID id, int32_t target);
+
+/**
+ * @brief 以当前目标为基准做相对移动（仅位置模式下有效）
+ */
+bool MotorPos_Move(MotorID id, int32_t delta);
+
+void MotorPos_SetKp(MotorID id, int32_t kp);
+void MotorPos_SetVelLimit(MotorID id, int32_t vmax);
+void MotorPos_SetTolerance(MotorID id, int32_t tol);
+
+/**
+ * @brief 位置外环计算（1kHz中断中调用）
+ * @param position 当前累计计数
+ * @return 速度PID目标值（计数/ms，已限幅）
+ */
+int MotorPos_Update(MotorID id, int32_t position);
+
+/**
+ * @brief 编码器清零前调用，把目标平移到新坐标系，避免车轮跳动
+ */
+void MotorPos_Rebase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_POS_H */
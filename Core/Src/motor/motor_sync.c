@@ -0,0 +1,123 @@
+/**
+ * @file motor_sync.c
+ * @brief 四轮交叉耦合同步控制（全整型实现）
+ *
+ * 原理：
+ * 1. 每轴累计跟踪误差 E（Q8），按目标方向归一化（沿目标方向滞后为正），
+ *    每周期按 2^SYNC_LEAK_SHIFT 泄漏，避免长期漂移
+ * 2. 对启用的轮对求同步误差，滞后的一侧加速、领先的一侧减速；
+ *    归一化后原地转向、麦轮横移等反向轮对同样成立
+ * 3. 修正量在归一化坐标下计算，乘回目标方向；小数部分跨周期累加，限幅到 ±SYNC_CORR_LIMIT
+ */
+
+#include "motor_sync.h"
+
+/**
+ * @brief 轮对定义（与 SYNC_PAIR_* 位序一致）
+ */
+static const uint8_t sync_pairs[6][2] = {
+    { MOTOR_A, MOTOR_B },
+    { MOTOR_C, MOTOR_D },
+    { MOTOR_A, MOTOR_D },
+    { MOTOR_B, MOTOR_C },
+    { MOTOR_A, MOTOR_C },
+    { MOTOR_B, MOTOR_D },
+};
+
+/**
+ * @brief 同步状态（全整型）
+ */
+typedef struct {
+    int32_t lag_q8;     ///< 累计跟踪误差（Q8，计数）
+    int32_t kc;         ///< 耦合增益（实际值 = kc / 1000）
+    int32_t remainder;  ///< 修正量余数（单位 1/(1000·256) 计数/ms）
+    int8_t  dir;        ///< 目标方向（±1；0 = 目标为零，不参与同步）
+} SyncAxis;
+
+static SyncAxis sync_axes[4];
+static uint8_t pair_mask;
+
+void MotorSync_Init(void) {
+    pair_mask = 0;
+    for (int i = 0; i < 4; i++) {
+        sync_axes[i].lag_q8 = 0;
+        sync_axes[i].kc = SYNC_KC_DEFAULT;
+        sync_axes[i].remainder = 0;
+        sync_axes[i].dir = 0;
+    }
+}
+
+void MotorSync_SetPairs(uint8_t mask) {
+    pair_mask = mask & SYNC_PAIR_ALL;
+    for (int i = 0; i < 4; i++) {
+        sync_axes[i].lag_q8 = 0;
+        sync_axes[i].remainder = 0;
+    }
+}
+
+void MotorSync_SetGain(MotorID id, int32_t kc) {
+    sync_axes[id].kc = (kc < 0) ? 0 : kc;
+    sync_axes[id].remainder = 0;
+}
+
+/**
+ * @brief 同步修正计算
+ * @note 公式：corr_i = s_i · Kc_i · Σ_j (E_i - E_j) / 1000，
+ *       其中 s_i = sign(r_i)，E_i = Σ s_i·(r_i - y_i) 为沿目标方向的累计滞后
+ */
+void MotorSync_Update(const int setpoints[4], const int speeds[4],
+                      const bool eligible[4], int corr[4]) {
+    int32_t diff_q8[4] = { 0, 0, 0, 0 };
+
+    // 1. 更新累计跟踪误差（按目标方向归一化）；
+    //    不参与同步、目标为零或换向的轴清零，重新参与时从零开始
+    for (int i = 0; i < 4; i++) {
+        int8_t dir = (setpoints[i] > 0) ? 1 : ((setpoints[i] < 0) ? -1 : 0);
+        corr[i] = 0;
+        if (pair_mask == 0 || !eligible[i] || dir != sync_axes[i].dir) {
+            sync_axes[i].lag_q8 = 0;
+            sync_axes[i].remainder = 0;
+        }
+        sync_axes[i].dir = (pair_mask != 0 && eligible[i]) ? dir : 0;
+        if (sync_axes[i].dir == 0) {
+            continue;
+        }
+        sync_axes[i].lag_q8 += dir * (setpoints[i] - speeds[i]) * 256;
+        sync_axes[i].lag_q8 -= sync_axes[i].lag_q8 >> SYNC_LEAK_SHIFT;
+    }
+    if (pair_mask == 0) {
+        return;
+    }
+
+    // 2. 各轮对同步误差
+    for (int p = 0; p < 6; p++) {
+        uint8_t i = sync_pairs[p][0];
+        uint8_t j = sync_pairs[p][1];
+        if ((pair_mask & (1u << p)) == 0 ||
+            sync_axes[i].dir == 0 || sync_axes[j].dir == 0) {
+            continue;
+        }
+        int32_t e = sync_axes[i].lag_q8 - sync_axes[j].lag_q8;
+        diff_q8[i] += e;
+        diff_q8[j] -= e;
+    }
+
+    // 3. 修正量（归一化坐标，余数保留到下一周期，限幅时丢弃余数），乘回目标方向
+    for (int i = 0; i < 4; i++) {
+        if (sync_axes[i].dir == 0) {
+            continue;
+        }
+        int64_t acc = (int64_t)sync_axes[i].kc * diff_q8[i] + sync_axes[i].remainder;
+        int64_t cmd = acc / (1000 * 256);
+        sync_axes[i].remainder = (int32_t)(acc - cmd * (1000 * 256));
+
+        if (cmd > SYNC_CORR_LIMIT) {
+            cmd = SYNC_CORR_LIMIT;
+            sync_axes[i].remainder = 0;
+        } else if (cmd < -SYNC_CORR_LIMIT) {
+            cmd = -SYNC_CORR_LIMIT;
+            sync_axes[i].remainder = 0;
+        }
+        corr[i] = sync_axes[i].dir * (int)cmd;
+    }
+}
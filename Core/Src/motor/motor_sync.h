@@ -0,0 +1,68 @@
+/**
+ * @file motor_sync.h
+ * @brief 四轮交叉耦合同步控制
+ *
+ * @note 各轮跟踪误差（目标 - 实际）乘以目标方向 s = sign(r) 后经泄漏积分，
+ *       得到沿目标方向的累计滞后量 E；对每个启用的轮对 (i, j)，
+ *       同步误差 E_i - E_j 按 Kc 修正两轮的速度目标：
+ *         r_i += s_i·Kc·(E_i - E_j)，r_j -= s_j·Kc·(E_i - E_j)
+ *       归一化后两轮目标反向（原地转向、麦轮横移）时修正方向仍正确；
+ *       目标为零的轴不参与同步，换向时累计误差清零。
+ *       只有速度模式且未在自整定的轴参与同步。
+ */
+
+#ifndef __MOTOR_SYNC_H
+#define __MOTOR_SYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 轮对掩码（MotorSync_SetPairs） ------------------------------------------*/
+#define SYNC_PAIR_AB        (1u << 0)  ///< 前轴左右（A-B）
+#define SYNC_PAIR_CD        (1u << 1)  ///< 后轴左右（C-D）
+#define SYNC_PAIR_AD        (1u << 2)  ///< 对角（A-D，麦轮）
+#define SYNC_PAIR_BC        (1u << 3)  ///< 对角（B-C，麦轮）
+#define SYNC_PAIR_AC        (1u << 4)  ///< 左侧前后（A-C）
+#define SYNC_PAIR_BD        (1u << 5)  ///< 右侧前后（B-D）
+#define SYNC_PAIR_ALL       0x3Fu
+
+/* 默认参数 --------------------------------------------------------------*/
+#define SYNC_KC_DEFAULT     50     ///< 耦合增益（实际值 = Kc / 1000，1/ms）
+#define SYNC_LEAK_SHIFT     8      ///< 累计误差泄漏时间常数 2^8 ms
+#define SYNC_CORR_LIMIT     10     ///< 单轴修正量限幅（计数/ms）
+
+/**
+ * @brief 初始化（默认关闭所有轮对）
+ */
+void MotorSync_Init(void);
+
+/**
+ * @brief 设置参与同步的轮对（SYNC_PAIR_* 组合，0 = 关闭）
+ */
+void MotorSync_SetPairs(uint8_t mask);
+
+/**
+ * @brief 设置单轴耦合增益（实际值 = kc / 1000）
+ */
+void MotorSync_SetGain(MotorID id, int32_t kc);
+
+/**
+ * @brief 计算同步修正量（1kHz中断中调用）
+ * @param setpoints 各轴未修正的速度目标（计数/ms）
+ * @param speeds 各轴实际速度
+ * @param eligible 各轴是否参与同步
+ * @param corr 输出：各轴速度目标修正量（计数/ms）
+ */
+void MotorSync_Update(const int setpoints[4], const int speeds[4],
+                      const bool eligible[4], int corr[4]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_SYNC_H */
@@ -0,0 +1,428 @@
+/**
+ * @file motor_cal.c
+ * @brief 电机死区/非线性标定与逆查找表线性化（全整型实现）
+ *
+ * 流程（每个方向）：
+ * 1. RAMP ：占空比从0缓慢上升，速度达到 MOTOR_CAL_MOVE_THRESH 时记录起转占空比
+ * 2. STEP ：占空比 d_k = k·1000/MOTOR_CAL_STEPS，稳定后取平均速度 v_k
+ * 3. STOP ：输出0等待停车，然后换向或结束
+ * 结束后把 (d_k, v_k) 曲线求逆，得到速度等分点对应的占空比表。
+ */
+
+#include "motor_cal.h"
+#include "../autotune/autotune.h"
+#include "../current_loop/current_loop.h"
+#include "../sysid/sysid.h"
+#include "../bode/bode.h"
+#include "../motor_cmd/motor_cmd.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
+
+#define LUT_LEN          (MOTOR_CAL_STEPS + 1)
+#define STEP_DUTY(k)     ((OUTPUT_LIMIT * (k)) / MOTOR_CAL_STEPS)
+#define SEG_FINE         (OUTPUT_LIMIT_FINE / MOTOR_CAL_STEPS)  ///< 线性域每段宽度（Q6）
+#define REPORT_LEN       (2 * (MOTOR_CAL_BREAKAWAY_IDX + 1))    ///< 每轴上报条数
+#define REPORT_NONE      0xFFu
+
+/**
+ * @brief 标定阶段
+ */
+typedef enum {
+    CAL_IDLE = 0,
+    CAL_RAMP,
+    CAL_STEP,
+    CAL_STOP
+} CalPhase;
+
+/**
+ * @brief 单轴线性化表
+ */
+typedef struct {
+    uint16_t lut[2][LUT_LEN];   ///< 逆查找表（占空比，按方向）
+    uint16_t breakaway[2];      ///< 静摩擦起转占空比（按方向）
+    bool enabled;               ///< 是否启用线性化
+} CalTable;
+
+/**
+ * @brief 单轴标定运行状态
+ */
+typedef struct {
+    CalPhase phase;             ///< 当前阶段
+    MotorCalDir dir;            ///< 当前方向
+    uint8_t step;               ///< 当前台阶
+    uint16_t ticks;             ///< 本阶段已运行周期数（ms）
+    int duty;                   ///< 当前开环占空比（不带符号）
+    int32_t sum;                ///< 台阶内速度累计
+    int32_t meas[LUT_LEN];      ///< 各台阶平均速度（Q8，计数/ms）
+    CalTable staged;            ///< 标定中的新表，成功后整体生效
+    uint8_t report;             ///< 上报游标（REPORT_NONE = 无）
+} CalAxis;
+
+static CalTable cal_tables[4];
+static CalAxis cal_axes[4];
+static uint16_t still_ticks[4];  ///< 连续速度为0的周期数（起转补偿判定）
+
+/* 私有函数声明 */
+static void MotorCal_SetIdentity(CalTable *table);
+static bool MotorCal_IsMonotonic(const CalTable *table);
+static bool MotorCal_BuildLut(CalAxis *axis);
+static int MotorCal_Interp(const uint16_t *lut, int mag);
+static void MotorCal_Finish(MotorID id, bool success);
+
+void MotorCal_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        MotorCal_SetIdentity(&cal_tables[i]);
+        cal_axes[i].phase = CAL_IDLE;
+        cal_axes[i].report = REPORT_NONE;
+        still_ticks[i] = 0;
+    }
+}
+
+bool MotorCal_Start(MotorID id) {
+    CalAxis *axis = &cal_axes[id];
+
+    if (axis->phase != CAL_IDLE || Autotune_IsActive(id) || CurrentLoop_IsEnabled(id) ||
+        Sysid_IsActive(id) || Bode_IsActive(id)) {
+        return false;
+    }
+    axis->staged = cal_tables[id];
+    axis->dir = MOTOR_CAL_DIR_FWD;
+    axis->phase = CAL_RAMP;
+    axis->ticks = 0;
+    axis->duty = 0;
+    motor_status[id] |= MOTOR_FLAG_CALIBRATING;
+    return true;
+}
+
+void MotorCal_Abort(MotorID id) {
+    if (cal_axes[id].phase != CAL_IDLE) {
+        MotorCal_Finish(id, false);
+    }
+}
+
+bool MotorCal_IsActive(MotorID id) {
+    return cal_axes[id].phase != CAL_IDLE;
+}
+
+/**
+ * @brief 标定开环输出计算
+ */
+int MotorCal_Update(MotorID id, int speed) {
+    CalAxis *axis = &cal_axes[id];
+    int sign = (axis->dir == MOTOR_CAL_DIR_FWD) ? 1 : -1;
+    int v = speed * sign;  // 沿当前方向的速度
+
+    axis->ticks++;
+    switch (axis->phase) {
+        case CAL_RAMP:
+            // 1. 斜坡找起转点（每2ms加1）
+            if (v >= MOTOR_CAL_MOVE_THRESH) {
+                axis->staged.breakaway[axis->dir] = (uint16_t)axis->duty;
+                axis->meas[0] = 0;
+                axis->step = 1;
+                axis->ticks = 0;
+                axis->sum = 0;
+                axis->phase = CAL_STEP;
+            } else if ((axis->ticks & 1u) == 0u && ++axis->duty > OUTPUT_LIMIT) {
+                MotorCal_Finish(id, false);  // 满占空比仍不转
+                return 0;
+            }
+            break;
+
+        case CAL_STEP:
+            // 2. 台阶：稳定后累计速度
+            axis->duty = STEP_DUTY(axis->step);
+            if (axis->ticks > MOTOR_CAL_SETTLE_MS) {
+                axis->sum += v;
+            }
+            if (axis->ticks >= MOTOR_CAL_SETTLE_MS + MOTOR_CAL_MEAS_MS) {
+                axis->meas[axis->step] = (axis->sum * 256) / MOTOR_CAL_MEAS_MS;
+                axis->ticks = 0;
+                axis->sum = 0;
+                if (++axis->step > MOTOR_CAL_STEPS) {
+                    if (!MotorCal_BuildLut(axis)) {
+                        MotorCal_Finish(id, false);
+                        return 0;
+                    }
+                    axis->duty = 0;
+                    axis->phase = CAL_STOP;
+                }
+            }
+            break;
+
+        case CAL_STOP:
+            // 3. 停车，然后换向或结束
+            axis->duty = 0;
+            if (axis->ticks >= MOTOR_CAL_STOP_MS) {
+                if (axis->dir == MOTOR_CAL_DIR_FWD) {
+                    axis->dir = MOTOR_CAL_DIR_REV;
+                    axis->ticks = 0;
+                    axis->phase = CAL_RAMP;
+                } else {
+                    MotorCal_Finish(id, true);
+                }
+            }
+            break;
+
+        default:
+            return 0;
+    }
+    return axis->duty * sign;
+}
+
+/**
+ * @brief 线性化映射
+ * @note 线性域的 |u| 按 SEG_FINE 分段，段内线性插值；
+ *       |u| < MOTOR_CAL_DEADBAND_RAMP 时由 0 线性过渡到查表值，
+ *       微小输出（含Σ-Δ抖动的 ±1 LSB）不会直接跳到死区占空比。
+ *       车轮连续 MOTOR_CAL_STILL_MS 静止且指令超过 MOTOR_CAL_BREAK_GATE 时，
+ *       输出至少为起转占空比，一个周期内越过静摩擦，不再依赖积分累积；
+ *       低速转动时 1ms 增量多为0，不能据此判定静止
+ */
+int MotorCal_Linearize(MotorID id, int fine, int speed) {
+    const CalTable *table = &cal_tables[id];
+
+    if (speed != 0) {
+        still_ticks[id] = 0;
+    } else if (still_ticks[id] < MOTOR_CAL_STILL_MS) {
+        still_ticks[id]++;
+    }
+    if (!table->enabled || fine == 0) {
+        return fine;
+    }
+
+    int dir = (fine > 0) ? MOTOR_CAL_DIR_FWD : MOTOR_CAL_DIR_REV;
+    int mag = (fine > 0) ? fine : -fine;
+    const uint16_t *lut = table->lut[dir];
+    int ramp = MOTOR_CAL_DEADBAND_RAMP * PWM_FINE_SCALE;
+    int out;
+
+    if (mag < ramp) {
+        out = (MotorCal_Interp(lut, ramp) * mag) / ramp;
+    } else {
+        out = MotorCal_Interp(lut, mag);
+    }
+
+    if (still_ticks[id] >= MOTOR_CAL_STILL_MS && mag >= MOTOR_CAL_BREAK_GATE * PWM_FINE_SCALE) {
+        int kick = table->breakaway[dir] * PWM_FINE_SCALE;
+        if (out < kick) {
+            out = kick;
+        }
+    }
+    if (out > OUTPUT_LIMIT_FINE) {
+        out = OUTPUT_LIMIT_FINE;
+    }
+    return (dir == MOTOR_CAL_DIR_FWD) ? out : -out;
+}
+
+/**
+ * @brief 逆线性化：查找表单调不减，按段反插值
+ * @note 表项相等的平台段取段起点；超出满幅对应的占空比时返回满幅
+ */
+int MotorCal_Unlinearize(MotorID id, int duty) {
+    const CalTable *table = &cal_tables[id];
+
+    if (!table->enabled || duty == 0) {
+        return duty;
+    }
+
+    int dir = (duty > 0) ? MOTOR_CAL_DIR_FWD : MOTOR_CAL_DIR_REV;
+    int mag = (duty > 0) ? duty : -duty;
+    const uint16_t *lut = table->lut[dir];
+    int ramp = MOTOR_CAL_DEADBAND_RAMP * PWM_FINE_SCALE;
+    int edge = MotorCal_Interp(lut, ramp);
+    int out = OUTPUT_LIMIT_FINE;
+
+    if (mag < edge) {
+        out = (mag * ramp) / edge;
+    } else {
+        for (int j = 0; j < MOTOR_CAL_STEPS; j++) {
+            int hi = lut[j + 1] * PWM_FINE_SCALE;
+            if (mag <= hi) {
+                int lo = lut[j] * PWM_FINE_SCALE;
+                out = j * SEG_FINE;
+                if (hi > lo && mag > lo) {
+                    out += ((mag - lo) * SEG_FINE) / (hi - lo);
+                }
+                break;
+            }
+        }
+        if (out < ramp) {
+            out = ramp;  // 渐入区之外
+        }
+    }
+    return (dir == MOTOR_CAL_DIR_FWD) ? out : -out;
+}
+
+bool MotorCal_Enable(MotorID id, bool enable) {
+    if (enable && !MotorCal_IsMonotonic(&cal_tables[id])) {
+        return false;
+    }
+    cal_tables[id].enabled = enable;
+    return true;
+}
+
+/**
+ * @note 线性化开启时表项必须夹在相邻表项之间，保证查找表始终单调；
+ *       整表写入应先关闭线性化，写完后由 MotorCal_Enable() 整体校验
+ */
+bool MotorCal_SetEntry(MotorID id, MotorCalDir dir, uint8_t j, int value) {
+    CalTable *table = &cal_tables[id];
+
+    if (dir > MOTOR_CAL_DIR_REV || j > MOTOR_CAL_BREAKAWAY_IDX ||
+        value < 0 || value > OUTPUT_LIMIT) {
+        return false;
+    }
+    if (j == MOTOR_CAL_BREAKAWAY_IDX) {
+        table->breakaway[dir] = (uint16_t)value;
+        return true;
+    }
+    if (table->enabled &&
+        ((j > 0 && value < table->lut[dir][j - 1]) ||
+         (j < MOTOR_CAL_STEPS && value > table->lut[dir][j + 1]))) {
+        return false;
+    }
+    table->lut[dir][j] = (uint16_t)value;
+    return true;
+}
+
+void MotorCal_Report(MotorID id) {
+    cal_axes[id].report = 0;
+}
+
+/**
+ * @brief 上报队列处理：应答队列满时留到下个周期继续
+ */
+void MotorCal_Task(void) {
+    for (int i = 0; i < 4; i++) {
+        CalAxis *axis = &cal_axes[i];
+
+        while (axis->report < REPORT_LEN) {
+            uint8_t dir = axis->report / (MOTOR_CAL_BREAKAWAY_IDX + 1);
+            uint8_t j = axis->report % (MOTOR_CAL_BREAKAWAY_IDX + 1);
+            int32_t value = (j == MOTOR_CAL_BREAKAWAY_IDX) ? cal_tables[i].breakaway[dir]
+                                                           : cal_tables[i].lut[dir][j];
+            if (!Uart2DmaSendReply(MOTOR_CMD_CAL_LUT, (uint8_t)i,
+                                   (uint16_t)((dir << 8) | j), value)) {
+                return;
+            }
+            axis->report++;
+        }
+        axis->report = REPORT_NONE;
+    }
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 查表插值
+ * @param mag 线性域 |u|（Q6）
+ * @return 占空比（Q6）
+ */
+static int MotorCal_Interp(const uint16_t *lut, int mag) {
+    int j = mag / SEG_FINE;
+
+    if (j >= MOTOR_CAL_STEPS) {
+        return lut[MOTOR_CAL_STEPS] * PWM_FINE_SCALE;
+    }
+    int frac = mag - j * SEG_FINE;
+    return lut[j] * PWM_FINE_SCALE + ((lut[j + 1] - lut[j]) * PWM_FINE_SCALE * frac) / SEG_FINE;
+}
+
+static void MotorCal_SetIdentity(CalTable *table) {
+    for (int d = 0; d < 2; d++) {
+        for (int j = 0; j < LUT_LEN; j++) {
+            table->lut[d][j] = (uint16_t)STEP_DUTY(j);
+        }
+        table->breakaway[d] = 0;
+    }
+    table->enabled = false;  // 恒等表有截断误差，标定成功后才启用
+}
+
+/**
+ * @brief 查找表两个方向是否均单调不减（MotorCal_Unlinearize() 的前提）
+ */
+static bool MotorCal_IsMonotonic(const CalTable *table) {
+    for (int d = 0; d < 2; d++) {
+        for (int j = 0; j < MOTOR_CAL_STEPS; j++) {
+            if (table->lut[d][j] > table->lut[d][j + 1]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 由当前方向的 (d_k, v_k) 曲线生成逆查找表
+ * @return 满占空比速度过低（曲线无效）返回false
+ */
+static bool MotorCal_BuildLut(CalAxis *axis) {
+    int32_t *v = axis->meas;
+    uint16_t *lut = axis->staged.lut[axis->dir];
+
+    // 1. 速度曲线单调化
+    for (int k = 1; k < LUT_LEN; k++) {
+        if (v[k] < v[k - 1]) {
+            v[k] = v[k - 1];
+        }
+    }
+    int32_t vmax = v[MOTOR_CAL_STEPS];
+    if (vmax < (MOTOR_CAL_MOVE_THRESH * 256)) {
+        return false;
+    }
+
+    // 2. 死区：第一个转动台阶与下一台阶连线外推到速度0
+    int k0 = 1;
+    while (k0 < MOTOR_CAL_STEPS && v[k0] <= 0) {
+        k0++;
+    }
+    int32_t d0 = STEP_DUTY(k0 - 1);
+    if (k0 < MOTOR_CAL_STEPS && v[k0 + 1] > v[k0]) {
+        int32_t x = STEP_DUTY(k0) -
+                    (v[k0] * (STEP_DUTY(k0 + 1) - STEP_DUTY(k0))) / (v[k0 + 1] - v[k0]);
+        if (x > d0) {
+            d0 = (x < STEP_DUTY(k0)) ? x : STEP_DUTY(k0);
+        }
+    }
+    lut[0] = (uint16_t)d0;
+    lut[MOTOR_CAL_STEPS] = OUTPUT_LIMIT;
+
+    // 3. 逆插值：速度等分点 j·vmax/STEPS 所需的占空比
+    int k = k0;
+    for (int j = 1; j < MOTOR_CAL_STEPS; j++) {
+        int32_t target = (vmax * j) / MOTOR_CAL_STEPS;
+        while (k < MOTOR_CAL_STEPS && v[k] < target) {
+            k++;
+        }
+        int32_t d_hi = STEP_DUTY(k);
+        int32_t d_lo = (k == k0) ? d0 : STEP_DUTY(k - 1);
+        int32_t v_lo = (k == k0) ? 0 : v[k - 1];
+        int32_t d = d_hi;
+        if (v[k] > v_lo) {
+            d = d_lo + ((target - v_lo) * (d_hi - d_lo)) / (v[k] - v_lo);
+        }
+        if (d < lut[j - 1]) {
+            d = lut[j - 1];
+        }
+        lut[j] = (uint16_t)d;
+    }
+    return true;
+}
+
+/**
+ * @brief 结束标定：成功则新表整体生效并上报
+ */
+static void MotorCal_Finish(MotorID id, bool success) {
+    CalAxis *axis = &cal_axes[id];
+
+    axis->phase = CAL_IDLE;
+    motor_status[id] &= (uint16_t)~MOTOR_FLAG_CALIBRATING;
+    PID_Bumpless(id);  // 从开环输出无扰切回PID
+
+    if (success) {
+        cal_tables[id] = axis->staged;
+        cal_tables[id].enabled = true;
+        axis->report = 0;
+    }
+    Uart2DmaSendReply(MOTOR_CMD_CAL, (uint8_t)id, 0, success ? 1 : 0);
+}
@@ -0,0 +1,112 @@
+/**
+ * @file motor_cal.h
+ * @brief 电机死区/非线性标定与逆查找表线性化
+ *
+ * @note 标定在1kHz控制中断内开环运行，由 Update_Motors() 调用；可多轴同时标定（车轮需离地）。
+ *       每个方向：先以 1 占空比/2ms 的斜坡找静摩擦起转占空比，
+ *       再按 MOTOR_CAL_STEPS 个台阶测量稳态速度，生成逆查找表：
+ *         lut[j] = 达到 j/MOTOR_CAL_STEPS × 满占空比速度 所需的占空比
+ *       lut[0] 为动摩擦死区（指令小于 MOTOR_CAL_DEADBAND_RAMP 时由 0 渐入），
+ *       lut[MOTOR_CAL_STEPS] 固定为 OUTPUT_LIMIT。
+ *       结果以 MOTOR_CMD_CAL_LUT 应答帧逐条上报：
+ *         idx = (方向 << 8) | j，j = 0~MOTOR_CAL_STEPS 为表项，
+ *         j = MOTOR_CAL_BREAKAWAY_IDX 为起转占空比，value 为占空比（0~1000）
+ */
+
+#ifndef __MOTOR_CAL_H
+#define __MOTOR_CAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_CAL_STEPS          16     ///< 查找表分段数（表项数 = 分段数 + 1）
+#define MOTOR_CAL_BREAKAWAY_IDX  (MOTOR_CAL_STEPS + 1)  ///< 上报/设置起转占空比的子索引
+#define MOTOR_CAL_SETTLE_MS      300    ///< 每个台阶的稳定时间（ms）
+#define MOTOR_CAL_MEAS_MS        200    ///< 每个台阶的测量时间（ms）
+#define MOTOR_CAL_STOP_MS        500    ///< 换向前的停车时间（ms）
+#define MOTOR_CAL_MOVE_THRESH    1      ///< 判定起转的速度（计数/ms）
+#define MOTOR_CAL_BREAK_GATE     20     ///< 起转补偿的最小指令（线性域占空比）
+#define MOTOR_CAL_STILL_MS       20     ///< 连续静止该时间（ms）后才施加起转补偿
+#define MOTOR_CAL_DEADBAND_RAMP  20     ///< 死区补偿的渐入宽度（线性域占空比，0 到此值线性过渡）
+
+/**
+ * @brief 方向
+ */
+typedef enum {
+    MOTOR_CAL_DIR_FWD = 0,
+    MOTOR_CAL_DIR_REV
+} MotorCalDir;
+
+/**
+ * @brief 初始化（查找表为恒等映射，起转补偿为0，线性化关闭）
+ */
+void MotorCal_Init(void);
+
+/**
+ * @brief 启动单轴标定
+ * @return 该轴已在标定或正在自整定返回false
+ */
+bool MotorCal_Start(MotorID id);
+
+/**
+ * @brief 中止单轴标定（查找表不变）
+ */
+void MotorCal_Abort(MotorID id);
+
+bool MotorCal_IsActive(MotorID id);
+
+/**
+ * @brief 标定开环输出（1kHz中断中调用）
+ * @param speed 实际速度
+ * @return PWM输出值（±OUTPUT_LIMIT）
+ */
+int MotorCal_Update(MotorID id, int speed);
+
+/**
+ * @brief 线性化：把控制器输出映射为实际占空比（每轴每个控制周期调用一次）
+ * @param fine 控制器输出（Q6，±OUTPUT_LIMIT_FINE）
+ * @param speed 实际速度（连续 MOTOR_CAL_STILL_MS 为0时施加起转补偿）
+ * @return 占空比（Q6，±OUTPUT_LIMIT_FINE）
+ */
+int MotorCal_Linearize(MotorID id, int fine, int speed);
+
+/**
+ * @brief 逆线性化：把占空比换算回控制器输出（输出限幅时回写积分用）
+ * @param duty 占空比（Q6，±OUTPUT_LIMIT_FINE）
+ * @return 控制器输出（Q6，±OUTPUT_LIMIT_FINE），不含起转补偿
+ */
+int MotorCal_Unlinearize(MotorID id, int duty);
+
+/**
+ * @brief 开关单轴线性化（默认关闭，标定成功后自动开启）
+ * @return 开启时查找表不单调返回false，保持原状态
+ */
+bool MotorCal_Enable(MotorID id, bool enable);
+
+/**
+ * @brief 手动写入表项
+ * @param j 0~MOTOR_CAL_STEPS 为表项，MOTOR_CAL_BREAKAWAY_IDX 为起转占空比
+ * @return 参数越界，或线性化开启时破坏单调性返回false
+ */
+bool MotorCal_SetEntry(MotorID id, MotorCalDir dir, uint8_t j, int value);
+
+/**
+ * @brief 请求上报单轴查找表
+ */
+void MotorCal_Report(MotorID id);
+
+/**
+ * @brief 上报队列处理（每个控制周期调用，按应答队列余量逐条发送）
+ */
+void MotorCal_Task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_CAL_H */
@@ -0,0 +1,414 @@
+/**
+ * motor_cmd.c
+ * -------------------------------------------------------------
+ * UART2 配置命令分发。在 UART 接收中断中执行，与 TIM6 控制中断
+ * 同优先级，不会互相抢占，因此参数可直接写入各模块。
+ */
+
+#include "motor_cmd.h"
+#include "../motor/motor_pid.h"
+#include "../motor/motor_pos.h"
+#include "../motor/motor_sync.h"
+#include "../autotune/autotune.h"
+#include "../motor/ax_motor.h"
+#include "../motor/ax_encoder.h"
+#include "../motor_cal/motor_cal.h"
+#include "../current_loop/current_loop.h"
+#include "../vbus_comp/vbus_comp.h"
+#include "../motor_protect/motor_protect.h"
+#include "../motor_slip/motor_slip.h"
+#include "../speed_est/speed_est.h"
+#include "../motor_dob/motor_dob.h"
+#include "../sysid/sysid.h"
+#include "../bode/bode.h"
+#include "../motor_filter/motor_filter.h"
+#include "../motor_ilc/motor_ilc.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
+
+/* --------------------------- 内部函数声明 ----------------------- */
+static bool isGlobal(uint8_t cmd);
+static bool execGlobal(uint8_t cmd, uint16_t idx, int32_t value);
+static bool execAxis(uint8_t cmd, MotorID id, uint16_t idx, int32_t value);
+static bool execCycles(int32_t value);
+
+/* =================================================================
+ * API
+ * ===============================================================*/
+bool MotorCmd_Execute(uint8_t cmd, uint8_t axis, uint16_t idx, int32_t value)
+{
+    if (cmd == MOTOR_CMD_CYCLES) {
+        return execCycles(value);
+    }
+    /* 与 axis 无关的命令只执行一次，axis = 0xFF 时不按轴重复 */
+    if (isGlobal(cmd)) {
+        return execGlobal(cmd, idx, value);
+    }
+
+    if (axis == MOTOR_CMD_AXIS_ALL) {
+        bool ok = true;
+        for (uint8_t i = 0; i < 4; ++i) {
+            ok = execAxis(cmd, (MotorID)i, idx, value) && ok;
+        }
+        return ok;
+    }
+
+    if (axis > MOTOR_D) {
+        return false;
+    }
+    return execAxis(cmd, (MotorID)axis, idx, value);
+}
+
+/* =================================================================
+ * 内部函数
+ * ===============================================================*/
+/**
+ * 是否为全局命令（与 axis 无关，作用于整机）
+ */
+static bool isGlobal(uint8_t cmd)
+{
+    switch (cmd)
+    {
+        case MOTOR_CMD_SYNC_PAIRS:
+        case MOTOR_CMD_DESAT:
+        case MOTOR_CMD_PWM_FREQ:
+        case MOTOR_CMD_VBUS_COMP:
+        case MOTOR_CMD_VBUS_NOM:
+        case MOTOR_CMD_SLIP_MODEL:
+        case MOTOR_CMD_SLIP_RATIO:
+        case MOTOR_CMD_TRACTION:
+        case MOTOR_CMD_SYSID_PARAM:
+        case MOTOR_CMD_BODE_PARAM:
+        case MOTOR_CMD_BODE_FREQ:
+        case MOTOR_CMD_ILC_PARAM:
+        case MOTOR_CMD_ILC_SYNC:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool execGlobal(uint8_t cmd, uint16_t idx, int32_t value)
+{
+    switch (cmd)
+    {
+        case MOTOR_CMD_SYNC_PAIRS:
+            MotorSync_SetPairs((uint8_t)value);
+            return true;
+
+        case MOTOR_CMD_DESAT:
+            PID_SetDesaturation(value != 0);
+            return true;
+
+        case MOTOR_CMD_PWM_FREQ:
+            if (value <= 0) {
+                return false;
+            }
+            if ((idx & 0x1u) == 0u) {
+                // 边沿对齐时电流采样落在导通边沿，电流环开启时不允许切换
+                for (int i = 0; i < 4; i++) {
+                    if (CurrentLoop_IsEnabled((MotorID)i)) {
+                        return false;
+                    }
+                }
+            }
+            return Motor_SetPwmConfig((uint32_t)value, (idx & 0x1u) != 0u);
+
+        case MOTOR_CMD_VBUS_COMP:
+            VbusComp_Enable(value != 0);
+            return true;
+
+        case MOTOR_CMD_VBUS_NOM:
+            if (value <= 0) {
+                return false;
+            }
+            return VbusComp_SetNominal((uint32_t)value);
+
+        case MOTOR_CMD_SLIP_MODEL:
+            if (value < 0) {
+                return false;
+            }
+            return MotorSlip_SetModel((MotorSlipModel)value);
+
+        case MOTOR_CMD_SLIP_RATIO:
+            MotorSlip_SetRatio(value);
+            return true;
+
+        case MOTOR_CMD_TRACTION:
+            MotorSlip_EnableTraction(value != 0);
+            return true;
+
+        case MOTOR_CMD_SYSID_PARAM:
+            return Sysid_SetParam((SysidParam)idx, value);
+
+        case MOTOR_CMD_BODE_PARAM:
+            return Bode_SetParam((BodeParam)idx, value);
+
+        case MOTOR_CMD_BODE_FREQ:
+            return Bode_SetFreq(idx, value);
+
+        case MOTOR_CMD_ILC_PARAM:
+            return MotorIlc_SetParam((MotorIlcParam)idx, value);
+
+        case MOTOR_CMD_ILC_SYNC:
+            MotorIlc_Sync();
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+static bool execAxis(uint8_t cmd, MotorID id, uint16_t idx, int32_t value)
+{
+    switch (cmd)
+    {
+        case MOTOR_CMD_MODE:
+            MotorPos_SetMode(id, (value != 0) ? MOTOR_MODE_POSITION : MOTOR_MODE_VELOCITY);
+            return true;
+
+        case MOTOR_CMD_POS_TARGET:
+            return MotorPos_SetTarget(id, value);
+
+        case MOTOR_CMD_POS_MOVE:
+            return MotorPos_Move(id, value);
+
+        case MOTOR_CMD_POS_VMAX:
+            MotorPos_SetVelLimit(id, value);
+            return true;
+
+        case MOTOR_CMD_POS_KP:
+            MotorPos_SetKp(id, value);
+            return true;
+
+        case MOTOR_CMD_POS_TOL:
+            MotorPos_SetTolerance(id, value);
+            return true;
+
+        case MOTOR_CMD_FF_KV:
+            return PID_SetParam(id, PID_PARAM_KV, value);
+
+        case MOTOR_CMD_FF_KA:
+            return PID_SetParam(id, PID_PARAM_KA, value);
+
+        case MOTOR_CMD_FF_KS:
+            return PID_SetParam(id, PID_PARAM_KS, value);
+
+        case MOTOR_CMD_PID_KP:
+            return PID_SetParam(id, PID_PARAM_KP, value);
+
+        case MOTOR_CMD_PID_KI:
+            return PID_SetParam(id, PID_PARAM_KI, value);
+
+        case MOTOR_CMD_PID_KD:
+            return PID_SetParam(id, PID_PARAM_KD, value);
+
+        case MOTOR_CMD_PID_KAW:
+            return PID_SetParam(id, PID_PARAM_KAW, value);
+
+        case MOTOR_CMD_PID_BETA:
+            return PID_SetParam(id, PID_PARAM_BETA, value);
+
+        case MOTOR_CMD_PID_DMODE:
+            return PID_SetParam(id, PID_PARAM_D_ON_MEAS, value);
+
+        case MOTOR_CMD_PID_DALPHA:
+            return PID_SetParam(id, PID_PARAM_D_ALPHA, value);
+
+        case MOTOR_CMD_AUTOTUNE:
+            if (value == 0) {
+                Autotune_Abort();
+                return true;
+            }
+            if (MotorCal_IsActive(id) || Sysid_IsActive(id) || Bode_IsActive(id)) {
+                return false;
+            }
+            return Autotune_Start(id, value, (AutotuneRule)(idx & 0xFFu), (idx & 0x100u) != 0u);
+
+        case MOTOR_CMD_SYNC_KC:
+            MotorSync_SetGain(id, value);
+            return true;
+
+        case MOTOR_CMD_DRIVE_MODE:
+            if (value < 0) {
+                return false;
+            }
+            return Motor_SetDriveMode((MotorChannel)id, (MotorDriveMode)value);
+
+        case MOTOR_CMD_CAL:
+            if (value == 0) {
+                MotorCal_Abort(id);
+                return true;
+            }
+            if (value == 2) {
+                MotorCal_Report(id);
+                return true;
+            }
+            return MotorCal_Start(id);
+
+        case MOTOR_CMD_CAL_LUT:
+            return MotorCal_SetEntry(id, (MotorCalDir)(idx >> 8), (uint8_t)(idx & 0xFFu), value);
+
+        case MOTOR_CMD_CAL_ENABLE:
+            return MotorCal_Enable(id, value != 0);
+
+        case MOTOR_CMD_CUR_ENABLE:
+            return CurrentLoop_Enable(id, value != 0);
+
+        case MOTOR_CMD_CUR_LIMIT:
+            if (value <= 0) {
+                return false;
+            }
+            CurrentLoop_SetLimit(id, value);
+            return true;
+
+        case MOTOR_CMD_CUR_KP:
+            CurrentLoop_SetKp(id, value);
+            return true;
+
+        case MOTOR_CMD_CUR_KI:
+            CurrentLoop_SetKi(id, value);
+            return true;
+
+        case MOTOR_CMD_STALL_DUTY:
+            return MotorProtect_SetParam(id, MOTOR_PROTECT_STALL_DUTY, value);
+
+        case MOTOR_CMD_STALL_MS:
+            return MotorProtect_SetParam(id, MOTOR_PROTECT_STALL_MS, value);
+
+        case MOTOR_CMD_STALL_HOLD:
+            return MotorProtect_SetParam(id, MOTOR_PROTECT_STALL_LIMIT, value);
+
+        case MOTOR_CMD_RATED_MA:
+            return MotorProtect_SetParam(id, MOTOR_PROTECT_RATED_MA, value);
+
+        case MOTOR_CMD_THERM_TAU:
+            return MotorProtect_SetParam(id, MOTOR_PROTECT_TAU_MS, value);
+
+        case MOTOR_CMD_SLIP_DIR:
+            return MotorSlip_SetDir(id, value);
+
+        case MOTOR_CMD_ENC_FILTER:
+            if (value < 0 || value > 15) {
+                return false;
+            }
+            return Encoder_SetFilter((EncoderMotorID)id, (uint8_t)value) != 0u;
+
+        case MOTOR_CMD_ENC_MAXD:
+            if (value <= 0) {
+                return false;
+            }
+            Encoder_SetMaxDelta((EncoderMotorID)id, value);
+            return true;
+
+        case MOTOR_CMD_ENC_DISC_MA:
+            Encoder_SetDisconnectCurrent((EncoderMotorID)id, value);
+            return true;
+
+        case MOTOR_CMD_ENC_FAULTS:
+            if (value == 1) {
+                Encoder_ClearFaults((EncoderMotorID)id);
+                return true;
+            }
+            if (value != 0) {
+                return false;
+            }
+            return Uart2DmaSendReply(MOTOR_CMD_ENC_FAULTS, (uint8_t)id, 0,
+                                     (int32_t)Encoder_GetFaultCount((EncoderMotorID)id, ENCODER_FAULT_SPIKE)) &&
+                   Uart2DmaSendReply(MOTOR_CMD_ENC_FAULTS, (uint8_t)id, 1,
+                                     (int32_t)Encoder_GetFaultCount((EncoderMotorID)id, ENCODER_FAULT_DISCONNECT)) &&
+                   Uart2DmaSendReply(MOTOR_CMD_ENC_FAULTS, (uint8_t)id, 2,
+                                     (int32_t)Encoder_IsFaulted((EncoderMotorID)id));
+
+        case MOTOR_CMD_EST_SOURCE:
+            if (value < 0) {
+                return false;
+            }
+            return SpeedEst_SetSource(id, (SpeedEstSource)value);
+
+        case MOTOR_CMD_EST_THETA:
+            return SpeedEst_SetTheta(id, value);
+
+        case MOTOR_CMD_EST_WINDOW:
+            return SpeedEst_SetWindow(id, value);
+
+        case MOTOR_CMD_DOB_ENABLE:
+            MotorDob_Enable(id, value != 0);
+            return true;
+
+        case MOTOR_CMD_DOB_GAIN:
+            MotorDob_SetGain(id, value);
+            return true;
+
+        case MOTOR_CMD_SYSID:
+            if (value == 0) {
+                Sysid_Abort();
+                return true;
+            }
+            if (value == 2) {
+                return Sysid_Upload();
+            }
+            return Sysid_Start(id);
+
+        case MOTOR_CMD_BODE:
+            if (value == 0) {
+                Bode_Abort();
+                return true;
+            }
+            if (value == 2) {
+                return Bode_Report();
+            }
+            return Bode_Start(id);
+
+        case MOTOR_CMD_FILT_STAGES:
+            return MotorFilter_SetStages(id, (MotorFilterPath)idx, value);
+
+        case MOTOR_CMD_FILT_COEF:
+            return MotorFilter_SetCoef(id, (MotorFilterPath)(idx >> 8), (uint8_t)((idx >> 4) & 0xFu),
+                                       (MotorFilterCoef)(idx & 0xFu), value);
+
+        case MOTOR_CMD_FILT_NOTCH:
+            return MotorFilter_SetNotch(id, (MotorFilterPath)(idx >> 8), (uint8_t)(idx & 0xFFu),
+                                        value & 0xFFFF, (int32_t)((uint32_t)value >> 16));
+
+        case MOTOR_CMD_ILC:
+            if (value == 3) {
+                MotorIlc_Clear(id);
+                return true;
+            }
+            if (value < 0) {
+                return false;
+            }
+            return MotorIlc_SetMode(id, (MotorIlcMode)value);
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * 执行时间上报/清零（电流环、速度环、滤波链三组统计）
+ */
+static bool execCycles(int32_t value)
+{
+    CycleMeter *meters[3] = { CurrentLoop_GetMeter(), PID_GetMeter(), MotorFilter_GetMeter() };
+    bool ok = true;
+
+    if (value == 1) {
+        for (uint16_t m = 0; m < 3u; ++m) {
+            CycleMeter_Reset(meters[m]);
+        }
+        return true;
+    }
+    if (value != 0) {
+        return false;
+    }
+    for (uint16_t m = 0; m < 3u; ++m) {
+        uint16_t base = (uint16_t)(m * 3u);
+        ok = Uart2DmaSendReply(MOTOR_CMD_CYCLES, 0, base, (int32_t)meters[m]->last) && ok;
+        ok = Uart2DmaSendReply(MOTOR_CMD_CYCLES, 0, base + 1u, (int32_t)meters[m]->max) && ok;
+        ok = Uart2DmaSendReply(MOTOR_CMD_CYCLES, 0, base + 2u,
+                               (int32_t)CycleMeter_Average(meters[m])) && ok;
+    }
+    return ok;
+}
@@ -0,0 +1,150 @@
+/**
+ * motor_cmd.h
+ * -------------------------------------------------------------
+ * UART2 配置命令分发（由 '$' 命令帧触发，见 uart2_motor_frame.c）
+ *
+ * 命令帧格式（10 字节，小端）：
+ *   [0]        0x24 '$'                —— 帧头
+ *   [1]        cmd   命令号            —— MotorCmdID
+ *   [2]        axis  电机号            —— 0~3，0xFF = 全部四轴
+ *   [3]~[4]    idx   uint16            —— 子索引（命令相关，不用时填0）
+ *   [5]~[8]    value int32             —— 参数值
+ *   [9]        0x21 '!'                —— 帧尾
+ *
+ * 执行失败（命令号未知、参数越界或状态不允许）时回复 NAK 应答帧：
+ *   cmd、axis 与请求相同，idx = MOTOR_CMD_NAK_IDX，value = 请求的 idx
+ */
+
+#ifndef MOTOR_CMD_H
+#define MOTOR_CMD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_CMD_AXIS_ALL   0xFFu   /* axis 字段：作用于全部四轴 */
+#define MOTOR_CMD_NAK_IDX    0xFFFFu /* 应答 idx：命令执行失败（NAK）   */
+
+/* 命令号 ------------------------------------------------------------------*/
+typedef enum {
+    MOTOR_CMD_MODE       = 0x01,  /* 运行模式：value 0=速度 1=位置        */
+    MOTOR_CMD_POS_TARGET = 0x02,  /* 绝对目标位置（编码器计数）           */
+    MOTOR_CMD_POS_MOVE   = 0x03,  /* 相对移动（在当前目标上累加）         */
+    MOTOR_CMD_POS_VMAX   = 0x04,  /* 位置模式速度限幅（计数/ms）          */
+    MOTOR_CMD_POS_KP     = 0x05,  /* 位置环 Kp（实际值 = value / 1000）   */
+    MOTOR_CMD_POS_TOL    = 0x06,  /* 到位窗口（±计数）                    */
+
+    MOTOR_CMD_FF_KV      = 0x10,  /* 速度前馈 kV（×100）                  */
+    MOTOR_CMD_FF_KA      = 0x11,  /* 加速度前馈 kA（×100）                */
+    MOTOR_CMD_FF_KS      = 0x12,  /* 静摩擦补偿 kS（PWM ×100）            */
+    MOTOR_CMD_PID_KP     = 0x13,  /* 速度环 Kp（×100）                    */
+    MOTOR_CMD_PID_KI     = 0x14,  /* 速度环 Ki（×100）                    */
+    MOTOR_CMD_PID_KD     = 0x15,  /* 速度环 Kd（×100）                    */
+    MOTOR_CMD_PID_KAW    = 0x16,  /* 抗饱和反算系数（0~100 %/周期）       */
+    MOTOR_CMD_PID_BETA   = 0x17,  /* 比例项目标权重 β（0~100 %）          */
+    MOTOR_CMD_PID_DMODE  = 0x18,  /* 微分来源：1=测量值 0=误差            */
+    MOTOR_CMD_PID_DALPHA = 0x19,  /* 微分滤波系数（1~256，256=不滤波）    */
+
+    MOTOR_CMD_AUTOTUNE   = 0x20,  /* 继电器自整定：value=继电器幅值(PWM)，
+                                     0 = 中止；idx 低字节=AutotuneRule，
+                                     idx bit8=1 完成后写入PID参数。
+                                     结果以同命令号应答帧上报           */
+
+    MOTOR_CMD_SYNC_PAIRS = 0x30,  /* 交叉耦合轮对掩码（SYNC_PAIR_*，0=关），
+                                     与 axis 无关                       */
+    MOTOR_CMD_SYNC_KC    = 0x31,  /* 交叉耦合增益（实际值 = value / 1000）*/
+    MOTOR_CMD_DESAT      = 0x32,  /* 四轴协调去饱和：1=开 0=关，与 axis 无关 */
+
+    MOTOR_CMD_DRIVE_MODE = 0x40,  /* H桥驱动模式（MotorDriveMode）：
+                                     0=零指令制动 1=零指令滑行，2 不支持 */
+    MOTOR_CMD_CAL        = 0x41,  /* 死区/非线性标定：1=启动 0=中止 2=上报
+                                     查找表；完成时以同命令号应答 idx0 状态 */
+    MOTOR_CMD_CAL_LUT    = 0x42,  /* 写查找表项：idx=(方向<<8)|j，value=占空比；
+                                     标定结果也以此命令号逐条上报         */
+    MOTOR_CMD_CAL_ENABLE = 0x43,  /* 查表线性化：1=开 0=关；默认关，
+                                     标定成功后自动开，表不单调时拒绝开启 */
+    MOTOR_CMD_PWM_FREQ   = 0x44,  /* PWM频率（Hz），idx bit0=1 中心对齐；
+                                     四路共用 TIM1，与 axis 无关；
+                                     电流环开启时只能中心对齐             */
+    MOTOR_CMD_VBUS_COMP  = 0x45,  /* 母线电压前馈补偿：1=开 0=关（默认关），
+                                     与 axis 无关                       */
+    MOTOR_CMD_VBUS_NOM   = 0x46,  /* 补偿标称电压（mV），未设置时开启补偿
+                                     后锁存当时电压，与 axis 无关        */
+
+    MOTOR_CMD_CUR_ENABLE = 0x50,  /* 电流内环：1=开 0=关（标定中或边沿对齐
+                                     时不可开启）                         */
+    MOTOR_CMD_CUR_LIMIT  = 0x51,  /* 电流限幅（mA），速度环满输出对应此值 */
+    MOTOR_CMD_CUR_KP     = 0x52,  /* 电流环 Kp（Q8，占空比/ADC计数）      */
+    MOTOR_CMD_CUR_KI     = 0x53,  /* 电流环 Ki（Q8，每PWM周期）           */
+    MOTOR_CMD_CYCLES     = 0x54,  /* 执行时间（CPU周期）：0=上报 1=清零；
+                                     应答 idx0~2 电流环 最近/最大/平均，
+                                     idx3~5 速度环，idx6~8 滤波链（每周期
+                                     四轴合计），与 axis 无关            */
+
+    MOTOR_CMD_STALL_DUTY = 0x60,  /* 堵转判定占空比（0~1000）             */
+    MOTOR_CMD_STALL_MS   = 0x61,  /* 堵转判定时间（ms）                   */
+    MOTOR_CMD_STALL_HOLD = 0x62,  /* 堵转保持占空比（0~1000）             */
+    MOTOR_CMD_RATED_MA   = 0x63,  /* 热模型额定电流（mA）                 */
+    MOTOR_CMD_THERM_TAU  = 0x64,  /* 热模型时间常数（ms）                 */
+
+    MOTOR_CMD_SLIP_MODEL = 0x70,  /* 打滑检测运动学模型（MotorSlipModel）：
+                                     0=关 1=差速 2=麦轮，与 axis 无关     */
+    MOTOR_CMD_SLIP_RATIO = 0x71,  /* 打滑相对阈值（‰），与 axis 无关      */
+    MOTOR_CMD_SLIP_DIR   = 0x72,  /* 轮速方向：1=正转前进 -1=反转前进     */
+    MOTOR_CMD_TRACTION   = 0x73,  /* 牵引力控制：1=开 0=仅上报，与 axis 无关 */
+
+    MOTOR_CMD_ENC_FILTER = 0x80,  /* 编码器输入滤波 ICxF（0~15）          */
+    MOTOR_CMD_ENC_MAXD   = 0x81,  /* 最大可信增量（计数/ms），孤立超限剔除，
+                                     连续超限 3 次后接受读数            */
+    MOTOR_CMD_ENC_DISC_MA= 0x82,  /* 断线判定电流上限（mA）               */
+    MOTOR_CMD_ENC_FAULTS = 0x83,  /* 故障计数：0=上报 1=清零；应答 idx0 剔除次数，
+                                     idx1 断线次数，idx2 当前断线状态   */
+
+    MOTOR_CMD_EST_SOURCE = 0x90,  /* 速度环反馈来源：0=原始增量 1=α-β-γ估计
+                                     2=滑动窗口平均                     */
+    MOTOR_CMD_EST_THETA  = 0x91,  /* 估计器平滑参数 θ（‰，0~999）         */
+    MOTOR_CMD_EST_WINDOW = 0x92,  /* 滑动窗口长度（1/2/4/8/16 ms）        */
+
+    MOTOR_CMD_DOB_ENABLE = 0xA0,  /* 扰动观测器补偿：1=开 0=关（需 kV>0）  */
+    MOTOR_CMD_DOB_GAIN   = 0xA1,  /* 观测器 Q 滤波系数（Q8，1~256）       */
+
+    MOTOR_CMD_SYSID      = 0xB0,  /* 系统辨识：1=启动 0=中止 2=上传采集数据；
+                                     结束时应答 idx0 点数，上传前应答 idx2 点数 */
+    MOTOR_CMD_SYSID_PARAM= 0xB1,  /* 辨识参数：idx=SysidParam，与 axis 无关 */
+    MOTOR_CMD_SYSID_DATA = 0xB2,  /* 仅应答：idx=序号，value=(占空比Q3<<16)|增量 */
+
+    MOTOR_CMD_BODE       = 0xC0,  /* 频率响应扫频：1=启动 0=中止 2=重新上报结果；
+                                     全部完成后应答 idx0 频点数          */
+    MOTOR_CMD_BODE_PARAM = 0xC1,  /* 扫频参数：idx=BodeParam，与 axis 无关 */
+    MOTOR_CMD_BODE_FREQ  = 0xC2,  /* 频率表：idx=序号，value=频率（0.1Hz，0=结束），
+                                     与 axis 无关                       */
+    MOTOR_CMD_BODE_GAIN  = 0xC3,  /* 仅应答：idx=频点序号，value=增益（Q16）*/
+    MOTOR_CMD_BODE_PHASE = 0xC4,  /* 仅应答：idx=频点序号，value=相位（0.01°）*/
+
+    MOTOR_CMD_FILT_STAGES= 0xD0,  /* 滤波链启用级数（0=旁路）：idx=MotorFilterPath
+                                     0=速度反馈 1=PID输出；同时提交 0xD1/
+                                     0xD2 写入的系数（校验稳定与直流增益）*/
+    MOTOR_CMD_FILT_COEF  = 0xD1,  /* 写系数（Q14）：idx=(path<<8)|(级<<4)|系数，
+                                     系数 0~4 = b0 b1 b2 a1 a2，0xD0 时生效 */
+    MOTOR_CMD_FILT_NOTCH = 0xD2,  /* 片上设计陷波：idx=(path<<8)|级，
+                                     value=(Q×100<<16)|中心频率(0.1Hz)，
+                                     0xD0 时生效                        */
+
+    MOTOR_CMD_ILC        = 0xE0,  /* 迭代学习：0=关 1=学习 2=只回放 3=清零修正 */
+    MOTOR_CMD_ILC_PARAM  = 0xE1,  /* 学习参数：idx=MotorIlcParam，与 axis 无关 */
+    MOTOR_CMD_ILC_SYNC   = 0xE2,  /* 运动周期起点（开始新试次），与 axis 无关 */
+    MOTOR_CMD_ILC_RMS    = 0xE3   /* 仅应答：试次结束时上报，idx=试次序号，
+                                     value=RMS跟踪误差（计数/ms ×100）  */
+} MotorCmdID;
+
+/* 执行一条命令；命令号未知、电机号越界或当前状态不允许时返回 false */
+bool MotorCmd_Execute(uint8_t cmd, uint8_t axis, uint16_t idx, int32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOTOR_CMD_H */
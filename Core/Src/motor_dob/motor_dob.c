@@ -0,0 +1,74 @@
+/**
+ * @file motor_dob.c
+ * @brief 扰动观测器（全整型实现）
+ *
+ * 单位：模型与估计值均为 PWM ×100（与 PID_Control() 的前馈相同），
+ *       速度/加速度为 Q16（计数/ms、计数/ms²），加速度 ×1000 换算为计数/ms/s。
+ */
+
+#include "motor_dob.h"
+#include "../speed_est/speed_est.h"
+
+#define DOB_LIMIT  (OUTPUT_LIMIT * 100)  ///< 估计值限幅（PWM ×100）
+
+/**
+ * @brief 单轴观测器
+ */
+typedef struct {
+    bool enabled;     ///< 是否注入补偿
+    int32_t gain;     ///< Q 滤波系数（Q8）
+    int32_t d_hat;    ///< 扰动估计（PWM ×100）
+} DobAxis;
+
+static DobAxis dob_axes[4];
+
+void MotorDob_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        dob_axes[i].enabled = false;
+        dob_axes[i].gain = MOTOR_DOB_GAIN_DEFAULT;
+        dob_axes[i].d_hat = 0;
+    }
+}
+
+void MotorDob_Enable(MotorID id, bool enable) {
+    if (enable != dob_axes[id].enabled) {
+        PID_Bumpless(id);  // 补偿量突然出现/消失，由积分吸收
+    }
+    dob_axes[id].enabled = enable;
+}
+
+void MotorDob_SetGain(MotorID id, int32_t gain) {
+    dob_axes[id].gain = (gain < 1) ? 1 : (gain > 256) ? 256 : gain;
+}
+
+int MotorDob_Update(MotorID id, int applied, int kV, int kA, int kS) {
+    DobAxis *axis = &dob_axes[id];
+
+    if (kV <= 0) {
+        axis->d_hat = 0;
+        return 0;
+    }
+
+    // 1. 名义模型：维持当前速度/加速度所需的输出
+    int32_t v = SpeedEst_GetSpeedQ16(id);
+    int32_t a = SpeedEst_GetAccelQ16(id);
+    int sign = (v > 0) - (v < 0);
+    int64_t model = (((int64_t)kV * v + (int64_t)kA * a * 1000) >> SPEED_EST_FRAC_BITS) +
+                    (int64_t)kS * sign;
+
+    // 2. 实际输出 - 名义模型 = 输入端扰动，Q 滤波
+    int64_t applied_x100 = ((int64_t)applied * 100) >> PWM_FRAC_BITS;
+    int64_t raw = applied_x100 - model;
+    if (raw > DOB_LIMIT) {
+        raw = DOB_LIMIT;
+    } else if (raw < -DOB_LIMIT) {
+        raw = -DOB_LIMIT;
+    }
+    axis->d_hat += (int32_t)(((raw - axis->d_hat) * axis->gain) >> 8);
+
+    return axis->enabled ? (int)axis->d_hat : 0;
+}
+
+int MotorDob_GetEstimate(MotorID id) {
+    return (int)(dob_axes[id].d_hat / 100);
+}
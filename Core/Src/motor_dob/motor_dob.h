@@ -0,0 +1,60 @@
+/**
+ * @file motor_dob.h
+ * @brief 扰动观测器（负载转矩估计，无需电流传感器）
+ *
+ * @note 名义模型取速度环前馈参数（kV、kA、kS）描述的电机逆模型：
+ *         u_model = kV·v + kA·dv/dt + kS·sign(v)
+ *       v、dv/dt 来自 α-β-γ 估计器。上一周期实际输出与名义模型之差即为
+ *       折算到输入端的负载扰动，经 Q 滤波（一阶低通）后作为前馈叠加到PID输出：
+ *         d̂ += (u_applied - u_model - d̂) · g / 256
+ *       g = 32 时时间常数约 8ms，负载突变在数毫秒内被补偿，积分只需处理模型误差。
+ *       kV ≤ 0（未整定前馈）时名义模型无效，观测器不输出。
+ *       估计值（PWM，正值表示阻碍正转的负载）随遥测上报。
+ */
+
+#ifndef __MOTOR_DOB_H
+#define __MOTOR_DOB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_DOB_GAIN_DEFAULT   32    ///< 默认 Q 滤波系数（Q8，1~256）
+
+/**
+ * @brief 初始化（全部关闭，估计值清零）
+ */
+void MotorDob_Init(void);
+
+/**
+ * @brief 开关单轴扰动补偿（关闭时仍估计并上报，但不注入）
+ */
+void MotorDob_Enable(MotorID id, bool enable);
+
+/**
+ * @brief 设置 Q 滤波系数（Q8，1~256）
+ */
+void MotorDob_SetGain(MotorID id, int32_t gain);
+
+/**
+ * @brief 更新估计并返回补偿量（PID_Control() 内每周期调用）
+ * @param applied 上一周期实际输出（PWM，Q6）
+ * @param kV/kA/kS 名义模型参数（与前馈同单位，×100）
+ * @return 补偿量（PWM ×100），未启用返回0
+ */
+int MotorDob_Update(MotorID id, int applied, int kV, int kA, int kS);
+
+/**
+ * @brief 负载扰动估计值（PWM）
+ */
+int MotorDob_GetEstimate(MotorID id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_DOB_H */
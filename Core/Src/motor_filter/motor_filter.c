@@ -0,0 +1,245 @@
+/**
+ * @file motor_filter.c
+ * @brief 速度环双二阶滤波链（全整型实现）
+ */
+
+#include "motor_filter.h"
+#include "../fixmath/fixmath.h"
+
+#define COEF_ONE          (1L << MOTOR_FILTER_COEF_BITS)
+#define PHASE_PER_DHZ     (FIX_PHASE_PER_HZ_1KHZ / 10u)
+
+/**
+ * @brief 单级状态与系数
+ */
+typedef struct {
+    int32_t coef[MOTOR_FILTER_COEF_COUNT];  ///< b0 b1 b2 a1 a2（Q14）
+    int32_t x1, x2;                         ///< 输入历史
+    int32_t y1, y2;                         ///< 输出历史
+    int64_t rem;                            ///< 截断余数（误差反馈）
+} BiquadStage;
+
+/**
+ * @brief 单个插入点的滤波链
+ */
+typedef struct {
+    BiquadStage stages[MOTOR_FILTER_MAX_STAGES];
+    int32_t shadow[MOTOR_FILTER_MAX_STAGES][MOTOR_FILTER_COEF_COUNT];  ///< 待生效系数（Q14）
+    uint8_t count;        ///< 启用级数
+    bool primed;          ///< 历史值有效
+    bool prime_set;       ///< 已指定起步值（否则以下一个输入起步）
+    int32_t prime_value;  ///< 起步值
+} BiquadChain;
+
+static BiquadChain chains[4][MOTOR_FILTER_PATH_COUNT];
+static CycleMeter filter_meter;
+static uint32_t tick_cycles;  ///< 本周期累计执行时间
+
+/* 私有函数声明 */
+static bool Biquad_IsStable(const int32_t *coef);
+static bool Biquad_IsUnitDc(const int32_t *coef);
+static void Chain_Prime(BiquadChain *chain, int32_t value);
+static int32_t DivRound(int64_t num, int64_t den);
+
+void MotorFilter_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        for (int p = 0; p < MOTOR_FILTER_PATH_COUNT; p++) {
+            BiquadChain *chain = &chains[i][p];
+            for (int s = 0; s < MOTOR_FILTER_MAX_STAGES; s++) {
+                BiquadStage *st = &chain->stages[s];
+                for (int c = 0; c < MOTOR_FILTER_COEF_COUNT; c++) {
+                    st->coef[c] = (c == MOTOR_FILTER_B0) ? COEF_ONE : 0;
+                    chain->shadow[s][c] = st->coef[c];
+                }
+            }
+            chain->count = 0;
+            chain->primed = false;
+            chain->prime_set = false;
+            chain->prime_value = 0;
+        }
+    }
+    tick_cycles = 0;
+    CycleMeter_Reset(&filter_meter);
+}
+
+bool MotorFilter_SetStages(MotorID id, MotorFilterPath path, int32_t stages) {
+    if (path >= MOTOR_FILTER_PATH_COUNT || stages < 0 || stages > MOTOR_FILTER_MAX_STAGES) {
+        return false;
+    }
+    BiquadChain *chain = &chains[id][path];
+    for (int32_t s = 0; s < stages; s++) {
+        if (!Biquad_IsStable(chain->shadow[s]) || !Biquad_IsUnitDc(chain->shadow[s])) {
+            return false;
+        }
+    }
+    // 影子系数整体生效（与控制中断同优先级，不会被半途打断）；
+    // 运行中的级保留历史值，只清除截断余数
+    for (int32_t s = 0; s < stages; s++) {
+        BiquadStage *st = &chain->stages[s];
+        for (int c = 0; c < MOTOR_FILTER_COEF_COUNT; c++) {
+            st->coef[c] = chain->shadow[s][c];
+        }
+        st->rem = 0;
+    }
+    if (chain->count == 0u) {
+        chain->primed = false;  // 从旁路切入：以下一个输入稳态起步
+        chain->prime_set = false;
+    } else {
+        // 新增的级以当前末级输出稳态起步
+        int32_t last = chain->stages[chain->count - 1u].y1;
+        for (int32_t s = chain->count; s < stages; s++) {
+            BiquadStage *st = &chain->stages[s];
+            st->x1 = last;
+            st->x2 = last;
+            st->y1 = last;
+            st->y2 = last;
+            st->rem = 0;
+        }
+    }
+    chain->count = (uint8_t)stages;
+    return true;
+}
+
+bool MotorFilter_SetCoef(MotorID id, MotorFilterPath path, uint8_t stage,
+                         MotorFilterCoef coef, int32_t value) {
+    if (path >= MOTOR_FILTER_PATH_COUNT || stage >= MOTOR_FILTER_MAX_STAGES ||
+        coef >= MOTOR_FILTER_COEF_COUNT ||
+        value > MOTOR_FILTER_COEF_MAX || value < -MOTOR_FILTER_COEF_MAX) {
+        return false;
+    }
+    chains[id][path].shadow[stage][coef] = value;  // 由 MotorFilter_SetStages() 校验并生效
+    return true;
+}
+
+/**
+ * @brief RBJ 陷波：ω0 = 2πf0/fs，α = sin ω0 / 2Q
+ *        a1 = -2cos ω0 / (1+α)，a2 = (1-α)/(1+α)，b1 = a1，b0 = b2 = (1 + a2)/2
+ * @note b0、b2 由量化后的 a2 推出，保证 Σb = 1 + a1 + a2，直流增益严格为 1
+ */
+bool MotorFilter_SetNotch(MotorID id, MotorFilterPath path, uint8_t stage,
+                          int32_t freq_dhz, int32_t q_x100) {
+    if (path >= MOTOR_FILTER_PATH_COUNT || stage >= MOTOR_FILTER_MAX_STAGES ||
+        freq_dhz <= 0 || freq_dhz >= 5000 || q_x100 < 10) {
+        return false;
+    }
+    uint32_t w0 = (uint32_t)freq_dhz * PHASE_PER_DHZ;
+    int64_t cos_q15 = Fix_CosQ15(w0);
+    int64_t alpha_q15 = ((int64_t)Fix_SinQ15(w0) * 100) / (2 * q_x100);
+    int64_t a0_q15 = 32768 + alpha_q15;
+    int32_t a1 = DivRound(-2 * cos_q15 * COEF_ONE, a0_q15);
+    int32_t a2 = DivRound((32768 - alpha_q15) * COEF_ONE, a0_q15);
+    int32_t *coef = chains[id][path].shadow[stage];
+
+    coef[MOTOR_FILTER_A1] = a1;
+    coef[MOTOR_FILTER_A2] = a2;
+    coef[MOTOR_FILTER_B1] = a1;
+    coef[MOTOR_FILTER_B0] = (COEF_ONE + a2) / 2;
+    coef[MOTOR_FILTER_B2] = COEF_ONE + a2 - coef[MOTOR_FILTER_B0];
+    return true;
+}
+
+bool MotorFilter_IsActive(MotorID id, MotorFilterPath path) {
+    return chains[id][path].count != 0u;
+}
+
+void MotorFilter_Prime(MotorID id, MotorFilterPath path, int32_t value) {
+    BiquadChain *chain = &chains[id][path];
+
+    chain->primed = false;
+    chain->prime_set = true;
+    chain->prime_value = value;
+}
+
+int32_t MotorFilter_Process(MotorID id, MotorFilterPath path, int32_t x) {
+    BiquadChain *chain = &chains[id][path];
+
+    if (chain->count == 0u) {
+        return x;
+    }
+
+    uint32_t t0 = DWT->CYCCNT;
+    int32_t v = x;
+
+    if (!chain->primed) {
+        Chain_Prime(chain, chain->prime_set ? chain->prime_value : v);
+    }
+    for (uint8_t s = 0; s < chain->count; s++) {
+        BiquadStage *st = &chain->stages[s];
+        int64_t acc = (int64_t)st->coef[MOTOR_FILTER_B0] * v +
+                      (int64_t)st->coef[MOTOR_FILTER_B1] * st->x1 +
+                      (int64_t)st->coef[MOTOR_FILTER_B2] * st->x2 -
+                      (int64_t)st->coef[MOTOR_FILTER_A1] * st->y1 -
+                      (int64_t)st->coef[MOTOR_FILTER_A2] * st->y2 +
+                      st->rem;
+        int32_t y = (int32_t)(acc >> MOTOR_FILTER_COEF_BITS);
+
+        st->rem = acc - ((int64_t)y << MOTOR_FILTER_COEF_BITS);
+        st->x2 = st->x1;
+        st->x1 = v;
+        st->y2 = st->y1;
+        st->y1 = y;
+        v = y;
+    }
+
+    tick_cycles += DWT->CYCCNT - t0;
+    return v;
+}
+
+void MotorFilter_EndTick(void) {
+    CycleMeter_Record(&filter_meter, tick_cycles);
+    tick_cycles = 0;
+}
+
+CycleMeter *MotorFilter_GetMeter(void) {
+    return &filter_meter;
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 稳定三角形：|a2| < 1 且 |a1| < 1 + a2
+ */
+static bool Biquad_IsStable(const int32_t *coef) {
+    int32_t a1 = coef[MOTOR_FILTER_A1];
+    int32_t a2 = coef[MOTOR_FILTER_A2];
+
+    if (a2 >= COEF_ONE || a2 <= -COEF_ONE) {
+        return false;
+    }
+    return ((a1 < 0) ? -a1 : a1) < COEF_ONE + a2;
+}
+
+/**
+ * @brief 直流增益 Σb / (1 + a1 + a2) 与 1 的偏差不超过 MOTOR_FILTER_DC_TOL_PERMIL
+ * @note 须在稳定性检查之后调用（此时分母 1 + a1 + a2 > 0）；
+ *       反馈路径增益不为 1 会产生稳态误差，预置历史值也以单位直流增益为前提
+ */
+static bool Biquad_IsUnitDc(const int32_t *coef) {
+    int64_t den = (int64_t)COEF_ONE + coef[MOTOR_FILTER_A1] + coef[MOTOR_FILTER_A2];
+    int64_t num = (int64_t)coef[MOTOR_FILTER_B0] + coef[MOTOR_FILTER_B1] + coef[MOTOR_FILTER_B2];
+    int64_t err = (num > den) ? num - den : den - num;
+
+    return err * 1000 <= den * MOTOR_FILTER_DC_TOL_PERMIL;
+}
+
+/**
+ * @brief 各级历史值置为稳态（按单位直流增益）
+ */
+static void Chain_Prime(BiquadChain *chain, int32_t value) {
+    for (int s = 0; s < MOTOR_FILTER_MAX_STAGES; s++) {
+        BiquadStage *st = &chain->stages[s];
+        st->x1 = value;
+        st->x2 = value;
+        st->y1 = value;
+        st->y2 = value;
+        st->rem = 0;
+    }
+    chain->primed = true;
+}
+
+/**
+ * @brief 四舍五入除法（den > 0）
+ */
+static int32_t DivRound(int64_t num, int64_t den) {
+    return (int32_t)((num >= 0) ? (num + den / 2) / den : (num - den / 2) / den);
+}
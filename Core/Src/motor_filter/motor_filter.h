@@ -0,0 +1,113 @@
+/**
+ * @file motor_filter.h
+ * @brief 速度环双二阶（biquad）滤波链：陷波/低通，抑制齿轮传动机械谐振
+ *
+ * @note 每轴两个插入点，各最多 MOTOR_FILTER_MAX_STAGES 级串联：
+ *       - FEEDBACK：速度反馈（SpeedEst_Feedback() 之后、PID之前），Q8 计数/ms，
+ *         输出保留小数直接送入PID
+ *       - OUTPUT：PID输出（去饱和之前），Q6 占空比域；
+ *         滤波后的值作为 raw_output 参与积分抗饱和
+ *       每级直接I型：
+ *         y = b0·x + b1·x1 + b2·x2 - a1·y1 - a2·y2
+ *       系数 Q14（a0 归一化为 1），64 位累加，截断余数反馈到下一周期（一阶误差反馈），
+ *       低频窄陷波也不会因截断产生直流偏差。
+ *       启用或无扰切换时历史值按单位直流增益预置为当前输入，不产生冲击。
+ *       陷波可由 MotorFilter_SetNotch() 在片上设计（RBJ 公式，直流增益严格为 1），
+ *       其余滤波器由主机计算系数后逐个写入。两者都只写影子系数，
+ *       由 MotorFilter_SetStages() 校验稳定性与直流增益后整体生效，
+ *       运行中的滤波器不会出现新旧系数混用的中间状态。
+ *       整条滤波链每周期的执行时间由 MotorFilter_GetMeter() 统计。
+ */
+
+#ifndef __MOTOR_FILTER_H
+#define __MOTOR_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+#include "../cycle_meter/cycle_meter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_FILTER_MAX_STAGES  4          ///< 每个插入点最多级数
+#define MOTOR_FILTER_COEF_BITS   14         ///< 系数小数位（Q14）
+#define MOTOR_FILTER_COEF_MAX    (8L << MOTOR_FILTER_COEF_BITS)  ///< 系数绝对值上限（±8.0）
+#define MOTOR_FILTER_DC_TOL_PERMIL  10      ///< 直流增益允许偏差（‰）
+
+/**
+ * @brief 插入点
+ */
+typedef enum {
+    MOTOR_FILTER_FEEDBACK = 0,  ///< 速度反馈
+    MOTOR_FILTER_OUTPUT,        ///< PID输出
+    MOTOR_FILTER_PATH_COUNT
+} MotorFilterPath;
+
+/**
+ * @brief 系数编号
+ */
+typedef enum {
+    MOTOR_FILTER_B0 = 0,
+    MOTOR_FILTER_B1,
+    MOTOR_FILTER_B2,
+    MOTOR_FILTER_A1,
+    MOTOR_FILTER_A2,
+    MOTOR_FILTER_COEF_COUNT
+} MotorFilterCoef;
+
+/**
+ * @brief 初始化（全部旁路，各级系数为直通 b0 = 1）
+ */
+void MotorFilter_Init(void);
+
+/**
+ * @brief 设置启用级数（0 = 旁路），同时使各启用级的影子系数整体生效
+ * @note 修改系数后以相同级数再次调用即可提交
+ * @return 级数越界，或任一启用级不稳定（|a2| ≥ 1 或 |a1| ≥ 1 + a2）、
+ *         直流增益偏离 1 超过 MOTOR_FILTER_DC_TOL_PERMIL 返回false（系数均不生效）
+ */
+bool MotorFilter_SetStages(MotorID id, MotorFilterPath path, int32_t stages);
+
+/**
+ * @brief 写入单个影子系数（Q14，MotorFilter_SetStages() 时生效）
+ * @return 编号或数值越界返回false
+ */
+bool MotorFilter_SetCoef(MotorID id, MotorFilterPath path, uint8_t stage,
+                         MotorFilterCoef coef, int32_t value);
+
+/**
+ * @brief 在片上设计陷波器并写入指定级的影子系数（MotorFilter_SetStages() 时生效）
+ * @param freq_dhz 陷波中心频率（0.1Hz，1 ~ 4999）
+ * @param q_x100 品质因数 Q（×100，≥ 10），带宽 = f0 / Q
+ * @return 参数越界返回false
+ */
+bool MotorFilter_SetNotch(MotorID id, MotorFilterPath path, uint8_t stage,
+                          int32_t freq_dhz, int32_t q_x100);
+
+bool MotorFilter_IsActive(MotorID id, MotorFilterPath path);
+
+/**
+ * @brief 预置历史值（下一次 MotorFilter_Process() 按该值稳态起步）
+ */
+void MotorFilter_Prime(MotorID id, MotorFilterPath path, int32_t value);
+
+/**
+ * @brief 滤波一个样本（1kHz中断中调用，旁路时原样返回）
+ * @param x 输入（FEEDBACK：Q8 计数/ms；OUTPUT：Q6 占空比）
+ */
+int32_t MotorFilter_Process(MotorID id, MotorFilterPath path, int32_t x);
+
+/**
+ * @brief 本周期滤波计算结束，记录执行时间（每个控制周期调用一次）
+ */
+void MotorFilter_EndTick(void);
+
+CycleMeter *MotorFilter_GetMeter(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_FILTER_H */
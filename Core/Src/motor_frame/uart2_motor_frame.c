@@ -14,11 +14,17 @@
  *   uart_set_speed[4]       —— 目标速度
  *   uart_angle_velocity[4]  —— 角度环速度输出
  *   trapezoidEnabled        —— 梯形加减速使能
+ *
+ * 另支持 10 字节配置命令帧（“$ ... !”，格式见 motor_cmd.h），
+ * 解析后交给 MotorCmd_Execute() 执行，执行失败时回复 NAK 应答帧。
  */
 
 #include "uart2_motor_frame.h"
 #include "usart.h"
 #include "../motor/ax_encoder.h"
+#include "../motor/motor_pos.h"
+#include "../motor_cmd/motor_cmd.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -28,7 +34,10 @@
 #define FRAME_TAIL      0x21u        /* '!': 帧尾 */
 #define CTRL_INDEX      5u           /* Ctrl 字节索引 */
 #define ANGLE_VEL_INDEX 6u           /* 角速度起始索引 */
-#define TAIL_INDEX      (FRAME_LEN - 1u)
+
+#define CMD_FRAME_LEN   10u          /* 命令帧长度 */
+#define CMD_FRAME_HEAD  0x24u        /* '$': 命令帧头 */
+#define RX_BUF_LEN      ((FRAME_LEN > CMD_FRAME_LEN) ? FRAME_LEN : CMD_FRAME_LEN)
 
 /* --------------------------- 状态机枚举 ------------------------- */
 typedef enum {
@@ -39,8 +48,9 @@ typedef enum {
 
 /* --------------------------- 静态变量 --------------------------- */
 static volatile uint8_t  rxByte;              /* 单字节中断缓冲 */
-static uint8_t           rxBuf[FRAME_LEN];    /* 帧缓存 */
+static uint8_t           rxBuf[RX_BUF_LEN];   /* 帧缓存 */
 static uint8_t           rxIndex  = 0;        /* 当前写入位置 */
+static uint8_t           rxLen    = FRAME_LEN;/* 当前帧总长（由帧头决定） */
 static RxState_t         rxState  = RX_WAIT_HEAD;
 
 /* --------------------------- 公共输出 --------------------------- */
@@ -50,6 +60,7 @@ volatile bool   trapezoidEnabled       = false;/* 梯形加减速使能 */
 
 /* --------------------------- 内部函数声明 ----------------------- */
 static void parseFrame(const uint8_t *buf);
+static void parseCmdFrame(const uint8_t *buf);
 static inline void restartRxIT(void)
 {
     HAL_UART_Receive_IT(&huart2, (uint8_t *)&rxByte, 1);
@@ -81,6 +92,7 @@ void MotorFrame_UART2_RxCallback(void)
         (seqBuf[(seqPos + 1U) % 3U] == '@') &&
         (seqBuf[(seqPos + 2U) % 3U] == '!'))
     {
+        MotorPos_Rebase();           /* 位置目标随坐标系平移 */
         Encoder_ResetAll();          /* <<< 立即复位编码器  */
         /* 重新清空检测器，防止后续字节误触发 */
         seqBuf[0] = seqBuf[1] = seqBuf[2] = 0;
@@ -88,29 +100,34 @@ void MotorFrame_UART2_RxCallback(void)
     }
 
     /* -----------------------------------------------------
-     * 2) 原有帧解析状态机 —— 完全保持原样
+     * 2) 帧解析状态机 —— 帧头决定帧长（'#' 速度帧 / '$' 命令帧）
      * ---------------------------------------------------*/
     switch (rxState)
     {
         case RX_WAIT_HEAD:
-            if (byte == FRAME_HEAD) {
+            if (byte == FRAME_HEAD || byte == CMD_FRAME_HEAD) {
                 rxBuf[0] = byte;
                 rxIndex  = 1;
+                rxLen    = (byte == FRAME_HEAD) ? FRAME_LEN : CMD_FRAME_LEN;
                 rxState  = RX_RECV_DATA;
             }
             break;
 
         case RX_RECV_DATA:
             rxBuf[rxIndex] = byte;
-            if (++rxIndex > (TAIL_INDEX - 1u)) {
+            if (++rxIndex > (rxLen - 2u)) {
                 rxState = RX_WAIT_TAIL;        /* 已收完数据区，等待帧尾 */
             }
             break;
 
         case RX_WAIT_TAIL:
             if (byte == FRAME_TAIL) {
-                rxBuf[TAIL_INDEX] = byte;
-                parseFrame(rxBuf);             /* 成功解析 */
+                rxBuf[rxLen - 1u] = byte;
+                if (rxBuf[0] == FRAME_HEAD) {
+                    parseFrame(rxBuf);         /* 成功解析 */
+                } else {
+                    parseCmdFrame(rxBuf);
+                }
             }
             rxState = RX_WAIT_HEAD;            /* 重置，无论成功失败 */
             break;
@@ -140,4 +157,20 @@ static void parseFrame(const uint8_t *buf)
     for (uint8_t i = 0; i < 4; ++i) {
         uart_angle_velocity[i] = (int8_t)buf[ANGLE_VEL_INDEX + i];
     }
-}
\ No newline at end of file
+}
+
+static void parseCmdFrame(const uint8_t *buf)
+{
+    uint8_t  cmd   = buf[1];
+    uint8_t  axis  = buf[2];
+    uint16_t idx   = (uint16_t)(buf[3] | ((uint16_t)buf[4] << 8));
+    int32_t  value = (int32_t)((uint32_t)buf[5]         |
+                               ((uint32_t)buf[6] << 8)  |
+                               ((uint32_t)buf[7] << 16) |
+                               ((uint32_t)buf[8] << 24));
+
+    if (!MotorCmd_Execute(cmd, axis, idx, value)) {
+        /* NAK：回显 cmd/axis，value 带回请求的 idx；应答队列满时丢弃 */
+        (void)Uart2DmaSendReply(cmd, axis, MOTOR_CMD_NAK_IDX, (int32_t)idx);
+    }
+}
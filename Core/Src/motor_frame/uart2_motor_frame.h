@@ -10,6 +10,8 @@
  *   [6]~[9]    4 路角度环速度输出 int8 —— 1 字节
  *   [10]       0x21 '!'                —— 帧尾
  *
+ * 另有 10 字节 '$' 配置命令帧，格式见 motor_cmd/motor_cmd.h。
+ *
  * API：
  *   MotorFrame_UART2_Init()        —— 启动单字节中断接收
  *   MotorFrame_UART2_RxCallback()  —— 在 USART2_IRQHandler 中调用
@@ -0,0 +1,309 @@
+/**
+ * @file motor_ilc.c
+ * @brief 迭代学习控制（全整型实现）
+ *
+ * 时序（抽取比 d）：
+ * 1. 试次内第 t 个周期：施加 u(t)（修正点线性插值，点 p 位于第 p 段中心）
+ * 2. 同一周期记录 e(t)，每 d 个周期得到一段平均误差 e_p
+ * 3. 得到 e_p 后平滑前一段：ẽ_{p-1} = (e_{p-2} + 2e_{p-1} + e_p)/4，
+ *    更新修正点 p-1-δ/d（该点本试次已施加完毕，可就地改写）
+ */
+
+#include "motor_ilc.h"
+#include "../fixmath/fixmath.h"
+#include "../motor_cmd/motor_cmd.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
+
+#define ILC_FRAC_BITS   4                         ///< 修正量与误差的小数位（Q4）
+#define ILC_ONE         (1 << ILC_FRAC_BITS)
+
+/**
+ * @brief 单轴学习状态（修正量存放在 ilc_buf）
+ */
+typedef struct {
+    MotorIlcMode mode;    ///< 工作模式
+    int32_t seg_sum;      ///< 本段误差累加（Q4）
+    uint8_t seg_n;        ///< 本段有效周期数
+    bool seg_ok;          ///< 本段全部周期有效
+    int32_t e_prev2;      ///< e_{p-2}（Q4）
+    int32_t e_prev1;      ///< e_{p-1}（Q4）
+    int32_t prev_p;       ///< e_{p-1} 所属段号，-1 = 无历史
+    uint64_t sq_sum;      ///< 本试次误差平方和（Q8）
+    uint32_t sq_n;        ///< 本试次有效周期数
+    uint16_t trials;      ///< 已完成试次数
+} IlcAxis;
+
+static int16_t ilc_buf[4][MOTOR_ILC_POINTS];   ///< 学习修正（Q4）
+static IlcAxis ilc_axes[4];
+static int32_t ilc_params[MOTOR_ILC_PARAM_COUNT];
+static bool running;                           ///< 试次进行中
+static uint32_t trial_tick;                    ///< 试次内周期序号
+
+/* 私有函数声明 */
+static bool Ilc_IsApplied(MotorID id);
+static int32_t Ilc_Correction(MotorID id);
+static void Ilc_ResetTrial(IlcAxis *axis);
+static void Ilc_EndSegment(MotorID id, int32_t p);
+static void Ilc_Learn(MotorID id, int32_t p, int32_t e_smooth);
+static void Ilc_EndTrial(void);
+
+void MotorIlc_Init(void) {
+    ilc_params[MOTOR_ILC_PARAM_TARGET] = MOTOR_ILC_TARGET_SETPOINT;
+    ilc_params[MOTOR_ILC_PARAM_LENGTH] = 2000;
+    ilc_params[MOTOR_ILC_PARAM_DECIM] = 2;
+    ilc_params[MOTOR_ILC_PARAM_GAIN] = 256;     // γ = 1
+    ilc_params[MOTOR_ILC_PARAM_LEAD] = 10;
+    ilc_params[MOTOR_ILC_PARAM_FORGET] = 0;
+    ilc_params[MOTOR_ILC_PARAM_LIMIT] = 100;
+    ilc_params[MOTOR_ILC_PARAM_AUTO] = 0;
+    for (int i = 0; i < 4; i++) {
+        ilc_axes[i].mode = MOTOR_ILC_OFF;
+        ilc_axes[i].trials = 0;
+        Ilc_ResetTrial(&ilc_axes[i]);
+        MotorIlc_Clear((MotorID)i);
+    }
+    running = false;
+    trial_tick = 0;
+}
+
+bool MotorIlc_SetParam(MotorIlcParam param, int32_t value) {
+    int32_t lo;
+    int32_t hi;
+    bool layout = false;
+
+    switch (param) {
+        case MOTOR_ILC_PARAM_TARGET: lo = 0; hi = MOTOR_ILC_TARGET_FEEDFORWARD; layout = true; break;
+        case MOTOR_ILC_PARAM_LENGTH:
+            lo = 1; hi = MOTOR_ILC_POINTS * ilc_params[MOTOR_ILC_PARAM_DECIM]; layout = true; break;
+        case MOTOR_ILC_PARAM_DECIM:  lo = 1; hi = MOTOR_ILC_DECIM_MAX; layout = true; break;
+        case MOTOR_ILC_PARAM_GAIN:   lo = 0; hi = 1024; break;
+        case MOTOR_ILC_PARAM_LEAD:   lo = 0; hi = 200; break;
+        case MOTOR_ILC_PARAM_FORGET: lo = 0; hi = 1000; break;
+        case MOTOR_ILC_PARAM_LIMIT:  lo = 0; hi = OUTPUT_LIMIT; break;
+        case MOTOR_ILC_PARAM_AUTO:   lo = 0; hi = 1; break;
+        default: return false;
+    }
+    if (value < lo || value > hi) {
+        return false;
+    }
+    if (layout) {
+        // 存储布局改变，已学习的修正失效
+        for (int i = 0; i < 4; i++) {
+            if (ilc_axes[i].mode != MOTOR_ILC_OFF) {
+                return false;
+            }
+        }
+        if (param == MOTOR_ILC_PARAM_DECIM &&
+            ilc_params[MOTOR_ILC_PARAM_LENGTH] > MOTOR_ILC_POINTS * value) {
+            ilc_params[MOTOR_ILC_PARAM_LENGTH] = MOTOR_ILC_POINTS * value;
+        }
+        for (int i = 0; i < 4; i++) {
+            MotorIlc_Clear((MotorID)i);
+        }
+        running = false;
+    }
+    ilc_params[param] = value;
+    return true;
+}
+
+bool MotorIlc_SetMode(MotorID id, MotorIlcMode mode) {
+    if (mode > MOTOR_ILC_REPLAY) {
+        return false;
+    }
+    ilc_axes[id].mode = mode;
+    Ilc_ResetTrial(&ilc_axes[id]);
+    if (mode == MOTOR_ILC_OFF) {
+        motor_status[id] &= (uint16_t)~MOTOR_FLAG_ILC;
+    }
+    return true;
+}
+
+void MotorIlc_Clear(MotorID id) {
+    for (uint32_t p = 0; p < MOTOR_ILC_POINTS; p++) {
+        ilc_buf[id][p] = 0;
+    }
+    ilc_axes[id].trials = 0;
+}
+
+void MotorIlc_Sync(void) {
+    if (running) {
+        Ilc_EndTrial();
+    }
+    running = true;
+    trial_tick = 0;
+}
+
+int MotorIlc_Setpoint(MotorID id, int setpoint) {
+    if (ilc_params[MOTOR_ILC_PARAM_TARGET] != MOTOR_ILC_TARGET_SETPOINT || !Ilc_IsApplied(id)) {
+        return setpoint;
+    }
+    return setpoint + (int)((Ilc_Correction(id) + ILC_ONE / 2) >> ILC_FRAC_BITS);
+}
+
+int MotorIlc_Output(MotorID id, int output) {
+    if (ilc_params[MOTOR_ILC_PARAM_TARGET] != MOTOR_ILC_TARGET_FEEDFORWARD || !Ilc_IsApplied(id)) {
+        return output;
+    }
+    return output + (int)(Ilc_Correction(id) * (PWM_FINE_SCALE / ILC_ONE));
+}
+
+void MotorIlc_Update(const int setpoints[4], const int speeds[4], const bool eligible[4]) {
+    if (!running) {
+        return;
+    }
+
+    uint32_t decim = (uint32_t)ilc_params[MOTOR_ILC_PARAM_DECIM];
+    bool seg_end = ((trial_tick + 1u) % decim) == 0u ||
+                   trial_tick + 1u >= (uint32_t)ilc_params[MOTOR_ILC_PARAM_LENGTH];
+
+    for (int i = 0; i < 4; i++) {
+        IlcAxis *axis = &ilc_axes[i];
+        if (axis->mode == MOTOR_ILC_OFF) {
+            continue;
+        }
+        if (eligible[i]) {
+            int32_t e = (setpoints[i] - speeds[i]) * ILC_ONE;
+            axis->seg_sum += e;
+            axis->seg_n++;
+            axis->sq_sum += (uint64_t)((int64_t)e * e);
+            axis->sq_n++;
+            motor_status[i] |= MOTOR_FLAG_ILC;
+        } else {
+            axis->seg_ok = false;
+            motor_status[i] &= (uint16_t)~MOTOR_FLAG_ILC;
+        }
+        if (seg_end) {
+            Ilc_EndSegment((MotorID)i, (int32_t)(trial_tick / decim));
+        }
+    }
+
+    if (++trial_tick >= (uint32_t)ilc_params[MOTOR_ILC_PARAM_LENGTH]) {
+        Ilc_EndTrial();
+        trial_tick = 0;
+        running = (ilc_params[MOTOR_ILC_PARAM_AUTO] != 0);
+        if (!running) {
+            for (int i = 0; i < 4; i++) {
+                motor_status[i] &= (uint16_t)~MOTOR_FLAG_ILC;
+            }
+        }
+    }
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+static bool Ilc_IsApplied(MotorID id) {
+    return ilc_axes[id].mode != MOTOR_ILC_OFF && running &&
+           trial_tick < (uint32_t)ilc_params[MOTOR_ILC_PARAM_LENGTH];
+}
+
+/**
+ * @brief 当前周期的修正量（Q4），点 p 位于 p·d + (d-1)/2，点间线性插值
+ */
+static int32_t Ilc_Correction(MotorID id) {
+    const int16_t *u = ilc_buf[id];
+    uint32_t decim = (uint32_t)ilc_params[MOTOR_ILC_PARAM_DECIM];
+    uint32_t points = ((uint32_t)ilc_params[MOTOR_ILC_PARAM_LENGTH] + decim - 1u) / decim;
+    uint32_t c0 = (decim - 1u) / 2u;
+
+    if (trial_tick <= c0) {
+        return u[0];
+    }
+    uint32_t p = (trial_tick - c0) / decim;
+    uint32_t f = (trial_tick - c0) % decim;
+    if (p + 1u >= points) {
+        return u[points - 1u];
+    }
+    return u[p] + ((int32_t)(u[p + 1u] - u[p]) * (int32_t)f) / (int32_t)decim;
+}
+
+/**
+ * @brief 清除单轴的试次内状态（已学习的修正保留）
+ */
+static void Ilc_ResetTrial(IlcAxis *axis) {
+    axis->seg_sum = 0;
+    axis->seg_n = 0;
+    axis->seg_ok = true;
+    axis->e_prev2 = 0;
+    axis->e_prev1 = 0;
+    axis->prev_p = -1;
+    axis->sq_sum = 0;
+    axis->sq_n = 0;
+}
+
+/**
+ * @brief 一段结束：得到段平均误差，平滑后更新前一段对应的修正点
+ * @note 含无效周期（模式切换、被接管）的段不参与学习，平滑历史随之断开
+ */
+static void Ilc_EndSegment(MotorID id, int32_t p) {
+    IlcAxis *axis = &ilc_axes[id];
+    bool valid = axis->seg_ok && axis->seg_n != 0u;
+    int32_t e = valid ? axis->seg_sum / (int32_t)axis->seg_n : 0;
+
+    axis->seg_sum = 0;
+    axis->seg_n = 0;
+    axis->seg_ok = true;
+    if (axis->mode != MOTOR_ILC_LEARN || !valid) {
+        if (axis->prev_p >= 0 && axis->mode == MOTOR_ILC_LEARN) {
+            // 历史断开：末端按 e_{p} = e_{p-1} 补齐
+            Ilc_Learn(id, axis->prev_p, (axis->e_prev2 + 3 * axis->e_prev1) / 4);
+        }
+        axis->prev_p = -1;
+        return;
+    }
+
+    if (axis->prev_p < 0) {
+        axis->e_prev1 = e;  // 首段：e_{p-1} 取 e_p
+    } else {
+        Ilc_Learn(id, axis->prev_p, (axis->e_prev2 + 2 * axis->e_prev1 + e) / 4);
+    }
+    axis->e_prev2 = axis->e_prev1;
+    axis->e_prev1 = e;
+    axis->prev_p = p;
+}
+
+/**
+ * @brief u(p - δ) ← (1 - λ)·u + γ·ẽ_p
+ */
+static void Ilc_Learn(MotorID id, int32_t p, int32_t e_smooth) {
+    int32_t decim = ilc_params[MOTOR_ILC_PARAM_DECIM];
+    int32_t q = p - (ilc_params[MOTOR_ILC_PARAM_LEAD] + decim / 2) / decim;
+    int32_t limit = ilc_params[MOTOR_ILC_PARAM_LIMIT] * ILC_ONE;
+
+    if (q < 0) {
+        return;
+    }
+    if (limit > INT16_MAX) {
+        limit = INT16_MAX;
+    }
+    int32_t u = ilc_buf[id][q];
+    u -= (u * ilc_params[MOTOR_ILC_PARAM_FORGET]) / 1000;
+    u += (ilc_params[MOTOR_ILC_PARAM_GAIN] * e_smooth) / 256;
+    if (u > limit) {
+        u = limit;
+    } else if (u < -limit) {
+        u = -limit;
+    }
+    ilc_buf[id][q] = (int16_t)u;
+}
+
+/**
+ * @brief 试次结束：补齐末段学习，上报各轴 RMS 跟踪误差（计数/ms ×100）
+ */
+static void Ilc_EndTrial(void) {
+    for (int i = 0; i < 4; i++) {
+        IlcAxis *axis = &ilc_axes[i];
+        if (axis->mode == MOTOR_ILC_OFF) {
+            continue;
+        }
+        if (axis->mode == MOTOR_ILC_LEARN && axis->prev_p >= 0) {
+            Ilc_Learn((MotorID)i, axis->prev_p, (axis->e_prev2 + 3 * axis->e_prev1) / 4);
+        }
+        if (axis->sq_n != 0u) {
+            uint32_t rms = Fix_Isqrt64(axis->sq_sum / axis->sq_n);  // Q4
+            axis->trials++;
+            Uart2DmaSendReply(MOTOR_CMD_ILC_RMS, (uint8_t)i, axis->trials,
+                              (int32_t)((rms * 100u) >> ILC_FRAC_BITS));
+        }
+        Ilc_ResetTrial(axis);
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * @file motor_ilc.h
+ * @brief 迭代学习控制（ILC）：重复运动周期的逐周期跟踪误差修正
+ *
+ * @note 每个运动周期（试次）由主机发送 MOTOR_CMD_ILC_SYNC 标记起点，
+ *       或开启自动重复后按设定长度首尾相接。试次内第 t 个控制周期施加学习修正 u(t)，
+ *       同时记录跟踪误差 e(t) = 目标 - 实际速度，就地更新下一试次的修正：
+ *         u(t) ← (1 - λ)·u(t) + γ·Q[e](t + δ)
+ *       - δ 超前量：补偿速度环响应滞后（学习收敛的关键）
+ *       - Q = (1,2,1)/4 零相位平滑，抑制高频误差的逐次放大
+ *       - λ 遗忘因子：防止非重复扰动在修正量中累积漂移
+ *       修正作用点可选：
+ *       - SETPOINT：叠加到速度目标（计数/ms），γ 无量纲
+ *       - FEEDFORWARD：叠加到PID输出（PWM），γ 单位 PWM/(计数/ms)；计入限幅前输出，不触发抗饱和
+ *       存储：每轴 MOTOR_ILC_POINTS 个 int16（Q4）修正点，每点覆盖 decim 个控制周期，
+ *       点间线性插值；误差按点平均后直接更新修正量，不单独保存误差序列，
+ *       四轴共 8KB，decim = 16 时可覆盖 16s 的运动周期。
+ *       仅速度模式且未被自整定/标定/辨识/扫频接管的轴施加与学习；
+ *       每个试次结束以 MOTOR_CMD_ILC_RMS 应答该轴 RMS 跟踪误差，用于观察收敛。
+ */
+
+#ifndef __MOTOR_ILC_H
+#define __MOTOR_ILC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_ILC_POINTS      1024   ///< 每轴修正点数
+#define MOTOR_ILC_DECIM_MAX   16     ///< 最大抽取比（每点覆盖的控制周期数）
+
+/**
+ * @brief 单轴工作模式
+ */
+typedef enum {
+    MOTOR_ILC_OFF = 0,    ///< 关闭（保留已学习的修正）
+    MOTOR_ILC_LEARN,      ///< 施加修正并逐试次学习
+    MOTOR_ILC_REPLAY      ///< 只施加修正，不再学习
+} MotorIlcMode;
+
+/**
+ * @brief 修正作用点
+ */
+typedef enum {
+    MOTOR_ILC_TARGET_SETPOINT = 0,  ///< 速度目标
+    MOTOR_ILC_TARGET_FEEDFORWARD    ///< PID输出（前馈）
+} MotorIlcTarget;
+
+/**
+ * @brief 可调参数编号（MOTOR_CMD_ILC_PARAM 的 idx，四轴共用）
+ */
+typedef enum {
+    MOTOR_ILC_PARAM_TARGET = 0,  ///< 作用点（MotorIlcTarget），各轴关闭时才可修改
+    MOTOR_ILC_PARAM_LENGTH,      ///< 试次长度（ms，≤ MOTOR_ILC_POINTS × decim），各轴关闭时才可修改
+    MOTOR_ILC_PARAM_DECIM,       ///< 抽取比（1~MOTOR_ILC_DECIM_MAX），各轴关闭时才可修改
+    MOTOR_ILC_PARAM_GAIN,        ///< 学习增益 γ（Q8，0~1024）
+    MOTOR_ILC_PARAM_LEAD,        ///< 超前量 δ（ms，0~200）
+    MOTOR_ILC_PARAM_FORGET,      ///< 遗忘因子 λ（‰/试次，0~1000）
+    MOTOR_ILC_PARAM_LIMIT,       ///< 修正量限幅（SETPOINT：计数/ms；FEEDFORWARD：PWM）
+    MOTOR_ILC_PARAM_AUTO,        ///< 1 = 试次结束后自动开始下一试次，0 = 等待 SYNC
+    MOTOR_ILC_PARAM_COUNT
+} MotorIlcParam;
+
+/**
+ * @brief 初始化（全部关闭，修正清零；默认作用于速度目标，试次 2000ms，
+ *        抽取 2，γ = 1，δ = 10ms，λ = 0，等待 SYNC）
+ */
+void MotorIlc_Init(void);
+
+/**
+ * @brief 修改参数
+ * @return 参数编号无效、数值越界，或有轴开启时修改存储布局相关参数返回false
+ */
+bool MotorIlc_SetParam(MotorIlcParam param, int32_t value);
+
+/**
+ * @brief 设置单轴工作模式
+ */
+bool MotorIlc_SetMode(MotorID id, MotorIlcMode mode);
+
+/**
+ * @brief 清零单轴已学习的修正
+ */
+void MotorIlc_Clear(MotorID id);
+
+/**
+ * @brief 运动周期起点（结束当前试次并开始新试次，与 axis 无关）
+ */
+void MotorIlc_Sync(void);
+
+/**
+ * @brief 施加速度目标修正（SETPOINT 模式，其余情况原样返回）
+ */
+int MotorIlc_Setpoint(MotorID id, int setpoint);
+
+/**
+ * @brief 施加输出前馈修正（FEEDFORWARD 模式，其余情况原样返回）
+ * @param output PID输出（Q6）
+ */
+int MotorIlc_Output(MotorID id, int output);
+
+/**
+ * @brief 记录跟踪误差、更新修正并推进试次时间（1kHz中断中每周期调用一次）
+ * @param setpoints 各轴速度目标（不含学习修正）
+ * @param speeds 各轴实际速度
+ * @param eligible 各轴是否参与（速度模式且未被接管）
+ */
+void MotorIlc_Update(const int setpoints[4], const int speeds[4], const bool eligible[4]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_ILC_H */
@@ -0,0 +1,187 @@
+/**
+ * @file motor_protect.c
+ * @brief 堵转检测与 I²t 热模型降额（全整型实现）
+ *
+ * 原理：
+ * 1. 负载率 r = |I| / I额定（Q10，上限4.0），功率项 P = r²（Q20）
+ * 2. heat += (P - heat) / τ，1kHz 下 τ 以 ms 计
+ * 3. 限幅 = 满幅 × (1.0 - heat) / (1.0 - 0.8)，heat ≤ 0.8 时为满幅
+ * 4. 堵转时限幅再取 min(热限幅, 堵转保持占空比)
+ */
+
+#include "motor_protect.h"
+#include "../adc_sense/adc_sense.h"
+
+#define LOAD_RATIO_MAX  (4 << 10)  ///< 负载率上限（Q10，4.0）
+
+/**
+ * @brief 单轴保护状态与参数
+ */
+typedef struct {
+    int32_t heat;         ///< 热模型状态（Q20，1.0 = 额定稳态）
+    uint16_t stall_ms;    ///< 堵转条件持续时间（ms）
+    bool stalled;         ///< 已判定堵转
+    int8_t stall_dir;     ///< 堵转方向（±1）
+    int limit;            ///< 当前输出限幅（Q6）
+
+    int stall_duty;       ///< 堵转判定占空比（0~1000）
+    uint16_t stall_time;  ///< 堵转判定时间（ms）
+    int stall_limit;      ///< 堵转保持占空比（0~1000）
+    int32_t rated_ma;     ///< 额定电流（mA）
+    int32_t tau_ms;       ///< 热时间常数（ms）
+} ProtectAxis;
+
+static ProtectAxis protect_axes[4];
+
+/* 私有函数声明 */
+static int32_t Protect_Heat(ProtectAxis *axis, MotorID id);
+static void Protect_Stall(ProtectAxis *axis, int request, int setpoint, int speed);
+
+void MotorProtect_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        ProtectAxis *axis = &protect_axes[i];
+
+        axis->heat = 0;
+        axis->stall_ms = 0;
+        axis->stalled = false;
+        axis->stall_dir = 0;
+        axis->limit = OUTPUT_LIMIT_FINE;
+        axis->stall_duty = MOTOR_PROTECT_STALL_DUTY_DEFAULT;
+        axis->stall_time = MOTOR_PROTECT_STALL_MS_DEFAULT;
+        axis->stall_limit = MOTOR_PROTECT_STALL_LIMIT_DEFAULT;
+        axis->rated_ma = MOTOR_PROTECT_RATED_MA_DEFAULT;
+        axis->tau_ms = MOTOR_PROTECT_TAU_MS_DEFAULT;
+        motor_status[i] &= (uint16_t)~(MOTOR_FLAG_STALL | MOTOR_FLAG_DERATE);
+    }
+}
+
+void MotorProtect_Update(MotorID id, int request, int setpoint, int speed) {
+    ProtectAxis *axis = &protect_axes[id];
+    int32_t heat = Protect_Heat(axis, id);
+    int limit = OUTPUT_LIMIT_FINE;
+
+    // 1. 热降额
+    if (heat >= MOTOR_PROTECT_HEAT_ONE) {
+        limit = 0;
+    } else if (heat > MOTOR_PROTECT_DERATE_START) {
+        limit = (int)(((int64_t)OUTPUT_LIMIT_FINE * (MOTOR_PROTECT_HEAT_ONE - heat)) /
+                      (MOTOR_PROTECT_HEAT_ONE - MOTOR_PROTECT_DERATE_START));
+    }
+    if (limit < OUTPUT_LIMIT_FINE) {
+        motor_status[id] |= MOTOR_FLAG_DERATE;
+    } else {
+        motor_status[id] &= (uint16_t)~MOTOR_FLAG_DERATE;
+    }
+
+    // 2. 堵转
+    Protect_Stall(axis, request, setpoint, speed);
+    if (axis->stalled) {
+        int stall_fine = axis->stall_limit * PWM_FINE_SCALE;
+        if (stall_fine < limit) {
+            limit = stall_fine;
+        }
+        motor_status[id] |= MOTOR_FLAG_STALL;
+    } else {
+        motor_status[id] &= (uint16_t)~MOTOR_FLAG_STALL;
+    }
+
+    axis->limit = limit;
+}
+
+int MotorProtect_GetLimit(MotorID id) {
+    return protect_axes[id].limit;
+}
+
+bool MotorProtect_SetParam(MotorID id, MotorProtectParam param, int32_t value) {
+    ProtectAxis *axis = &protect_axes[id];
+
+    switch (param) {
+        case MOTOR_PROTECT_STALL_DUTY:
+            if (value <= 0 || value > OUTPUT_LIMIT) {
+                return false;
+            }
+            axis->stall_duty = (int)value;
+            return true;
+        case MOTOR_PROTECT_STALL_MS:
+            if (value <= 0 || value > 0xFFFF) {
+                return false;
+            }
+            axis->stall_time = (uint16_t)value;
+            return true;
+        case MOTOR_PROTECT_STALL_LIMIT:
+            if (value < 0 || value > OUTPUT_LIMIT) {
+                return false;
+            }
+            axis->stall_limit = (int)value;
+            return true;
+        case MOTOR_PROTECT_RATED_MA:
+            if (value <= 0) {
+                return false;
+            }
+            axis->rated_ma = value;
+            return true;
+        case MOTOR_PROTECT_TAU_MS:
+            if (value <= 0) {
+                return false;
+            }
+            axis->tau_ms = value;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 热模型一步更新
+ * @return 更新后的 heat（Q20）
+ */
+static int32_t Protect_Heat(ProtectAxis *axis, MotorID id) {
+    int32_t ma = AdcSense_GetCurrent(id);
+    int32_t ratio;
+
+    if (ma < 0) {
+        ma = -ma;
+    }
+    ratio = (int32_t)(((int64_t)ma << 10) / axis->rated_ma);
+    if (ratio > LOAD_RATIO_MAX) {
+        ratio = LOAD_RATIO_MAX;
+    }
+
+    axis->heat += (ratio * ratio - axis->heat) / axis->tau_ms;
+    if (axis->heat < 0) {
+        axis->heat = 0;
+    }
+    return axis->heat;
+}
+
+/**
+ * @brief 堵转判定与解除
+ */
+static void Protect_Stall(ProtectAxis *axis, int request, int setpoint, int speed) {
+    int mag = (request < 0) ? -request : request;
+    int dir = (request < 0) ? -1 : 1;
+    bool moving = (speed > MOTOR_PROTECT_STALL_SPEED) || (speed < -MOTOR_PROTECT_STALL_SPEED);
+
+    if (axis->stalled) {
+        // 车轮转动、目标归零或反向时解除
+        if (moving || setpoint == 0 || (setpoint > 0 ? 1 : -1) != axis->stall_dir) {
+            axis->stalled = false;
+            axis->stall_ms = 0;
+        }
+        return;
+    }
+
+    if (!moving && mag >= axis->stall_duty * PWM_FINE_SCALE) {
+        if (axis->stall_ms < axis->stall_time) {
+            axis->stall_ms++;
+        }
+        if (axis->stall_ms >= axis->stall_time) {
+            axis->stalled = true;
+            axis->stall_dir = (int8_t)dir;
+        }
+    } else {
+        axis->stall_ms = 0;
+    }
+}
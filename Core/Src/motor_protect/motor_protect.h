@@ -0,0 +1,79 @@
+/**
+ * @file motor_protect.h
+ * @brief 堵转检测与 I²t 热模型降额
+ *
+ * @note 每个控制周期由 Update_Motors() 调用，输出为各轴的输出限幅（Q6），
+ *       代替固定的 OUTPUT_LIMIT_FINE 参与四轴协调去饱和：
+ *       - 热模型：一阶 I²t，heat += ((I/I额定)² - heat) / τ，
+ *         heat = 1.0 对应额定电流下的稳态温升。
+ *         heat 超过 MOTOR_PROTECT_DERATE_START 后限幅线性下降，至 1.0 时为0，
+ *         电机在不超温的前提下以最大可用功率继续运行
+ *       - 堵转：请求输出 ≥ 堵转占空比 且 |速度| ≤ MOTOR_PROTECT_STALL_SPEED
+ *         持续设定时间后判定堵转，限幅降到堵转保持占空比；
+ *         车轮转动、目标速度归零或反向时解除
+ *       状态由 MOTOR_FLAG_STALL / MOTOR_FLAG_DERATE 随遥测上报。
+ *       自整定/标定/辨识/扫频中的轴同样施加限幅（不参与四轴等比例缩放），
+ *       堵转解除条件中的目标速度以开环输出代替。
+ */
+
+#ifndef __MOTOR_PROTECT_H
+#define __MOTOR_PROTECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_PROTECT_HEAT_ONE        (1 << 20)  ///< 热模型 1.0（Q20）
+#define MOTOR_PROTECT_DERATE_START    ((MOTOR_PROTECT_HEAT_ONE * 4) / 5)  ///< 开始降额（0.8）
+#define MOTOR_PROTECT_STALL_SPEED     1      ///< 堵转判定速度上限（计数/ms）
+
+#define MOTOR_PROTECT_STALL_DUTY_DEFAULT   600    ///< 默认堵转判定占空比（0~1000）
+#define MOTOR_PROTECT_STALL_MS_DEFAULT     500    ///< 默认堵转判定时间（ms）
+#define MOTOR_PROTECT_STALL_LIMIT_DEFAULT  300    ///< 默认堵转保持占空比（0~1000）
+#define MOTOR_PROTECT_RATED_MA_DEFAULT     1000   ///< 默认额定电流（mA）
+#define MOTOR_PROTECT_TAU_MS_DEFAULT       30000  ///< 默认热时间常数（ms）
+
+/**
+ * @brief 可调参数编号
+ */
+typedef enum {
+    MOTOR_PROTECT_STALL_DUTY,   ///< 堵转判定占空比（0~1000）
+    MOTOR_PROTECT_STALL_MS,     ///< 堵转判定时间（ms）
+    MOTOR_PROTECT_STALL_LIMIT,  ///< 堵转保持占空比（0~1000）
+    MOTOR_PROTECT_RATED_MA,     ///< 额定（连续）电流（mA）
+    MOTOR_PROTECT_TAU_MS        ///< 热时间常数（ms）
+} MotorProtectParam;
+
+/**
+ * @brief 初始化（热模型清零，参数恢复默认）
+ */
+void MotorProtect_Init(void);
+
+/**
+ * @brief 更新单轴堵转检测与热模型（每个控制周期调用一次）
+ * @param request 限幅前的请求输出（Q6）
+ * @param setpoint 目标速度（计数/ms；被接管的轴传入开环输出，只用其符号）
+ * @param speed 实际速度（计数/ms）
+ */
+void MotorProtect_Update(MotorID id, int request, int setpoint, int speed);
+
+/**
+ * @brief 当前输出限幅（Q6，0~OUTPUT_LIMIT_FINE）
+ */
+int MotorProtect_GetLimit(MotorID id);
+
+/**
+ * @brief 修改参数
+ * @return 参数编号无效或数值越界返回false
+ */
+bool MotorProtect_SetParam(MotorID id, MotorProtectParam param, int32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_PROTECT_H */
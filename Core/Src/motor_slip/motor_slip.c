@@ -0,0 +1,204 @@
+/**
+ * @file motor_slip.c
+ * @brief 打滑检测与牵引力控制（全整型实现）
+ *
+ * 原理：
+ * 1. 各约束行 r = Σ w_i·d_i·v_i（d_i 为方向），rf += (r·16 - rf) / 8（rf 为 Q4）
+ * 2. |rf| 持续 MOTOR_SLIP_CONFIRM_MS 超过阈值 -> 按输出方向定位打滑轮
+ * 3. 打滑轮限幅：首次取 min(限幅, |u|)，之后每周期减 1/32；未打滑时线性回升
+ */
+
+#include "motor_slip.h"
+
+#define SLIP_ROWS_MAX  2  ///< 每种模型的最大约束行数
+
+/**
+ * @brief 约束行：r = Σ w[i]·v[i]
+ */
+typedef struct {
+    int8_t w[4];
+} SlipRow;
+
+static const SlipRow skid_rows[2] = {
+    { { 1, 0, -1,  0 } },  // 左侧：A - C
+    { { 0, 1,  0, -1 } }   // 右侧：B - D
+};
+static const SlipRow mecanum_rows[1] = {
+    { { 1, 1, -1, -1 } }   // A + B - C - D
+};
+
+static MotorSlipModel slip_model = MOTOR_SLIP_MODEL_NONE;  ///< 当前模型
+static int32_t slip_ratio = MOTOR_SLIP_RATIO_DEFAULT;      ///< 相对阈值（‰）
+static bool traction_enabled = true;                       ///< 牵引力控制开关
+static int8_t wheel_dir[4];                                ///< 各轴方向（±1）
+static int32_t resid_filt[SLIP_ROWS_MAX];                  ///< 滤波后的残差（Q4）
+static uint16_t resid_ms[SLIP_ROWS_MAX];                   ///< 残差持续超限时间
+static int slip_limit[4];                                  ///< 各轴牵引力限幅（Q6）
+
+/* 私有函数声明 */
+static int Slip_Locate(const SlipRow *row, int32_t resid, const int setpoints[4],
+                       const int speeds[4], const int applied[4], const bool eligible[4]);
+
+void MotorSlip_Init(void) {
+    slip_model = MOTOR_SLIP_MODEL_NONE;
+    slip_ratio = MOTOR_SLIP_RATIO_DEFAULT;
+    traction_enabled = true;
+    for (int i = 0; i < 4; i++) {
+        wheel_dir[i] = 1;
+        slip_limit[i] = OUTPUT_LIMIT_FINE;
+        motor_status[i] &= (uint16_t)~MOTOR_FLAG_SLIP;
+    }
+    for (int r = 0; r < SLIP_ROWS_MAX; r++) {
+        resid_filt[r] = 0;
+        resid_ms[r] = 0;
+    }
+}
+
+bool MotorSlip_SetModel(MotorSlipModel model) {
+    if (model > MOTOR_SLIP_MODEL_MECANUM) {
+        return false;
+    }
+    slip_model = model;
+    for (int r = 0; r < SLIP_ROWS_MAX; r++) {
+        resid_filt[r] = 0;
+        resid_ms[r] = 0;
+    }
+    return true;
+}
+
+void MotorSlip_SetRatio(int32_t ratio) {
+    slip_ratio = (ratio < 0) ? 0 : ratio;
+}
+
+bool MotorSlip_SetDir(MotorID id, int32_t dir) {
+    if (dir != 1 && dir != -1) {
+        return false;
+    }
+    wheel_dir[id] = (int8_t)dir;
+    return true;
+}
+
+void MotorSlip_EnableTraction(bool enable) {
+    traction_enabled = enable;
+    if (!enable) {
+        for (int i = 0; i < 4; i++) {
+            slip_limit[i] = OUTPUT_LIMIT_FINE;  // 关闭时立即撤销已降低的限幅
+        }
+    }
+}
+
+void MotorSlip_Update(const int setpoints[4], const int speeds[4],
+                      const int applied[4], const bool eligible[4]) {
+    const SlipRow *rows = 0;
+    int nrows = 0;
+    bool slipping[4] = { false, false, false, false };
+
+    if (slip_model == MOTOR_SLIP_MODEL_SKID) {
+        rows = skid_rows;
+        nrows = 2;
+    } else if (slip_model == MOTOR_SLIP_MODEL_MECANUM) {
+        rows = mecanum_rows;
+        nrows = 1;
+    }
+
+    // 1. 约束残差与定位
+    for (int r = 0; r < nrows; r++) {
+        int32_t resid = 0;
+        int32_t scale = 0;
+        bool valid = true;
+
+        for (int i = 0; i < 4; i++) {
+            if (rows[r].w[i] == 0) {
+                continue;
+            }
+            if (!eligible[i]) {
+                valid = false;  // 约束中有轴不在速度闭环，残差无意义
+                break;
+            }
+            int32_t v = rows[r].w[i] * wheel_dir[i] * speeds[i];
+            resid += v;
+            scale += (v < 0) ? -v : v;
+        }
+        if (!valid) {
+            resid_filt[r] = 0;
+            resid_ms[r] = 0;
+            continue;
+        }
+
+        resid_filt[r] += ((resid << 4) - resid_filt[r]) >> MOTOR_SLIP_FILTER_SHIFT;
+        int32_t mag = (resid_filt[r] < 0) ? -resid_filt[r] : resid_filt[r];
+        int32_t thresh = (MOTOR_SLIP_MIN_SPEED << 4) + ((scale << 4) * slip_ratio) / 1000;
+
+        if (mag <= thresh) {
+            resid_ms[r] = 0;
+            continue;
+        }
+        if (resid_ms[r] < MOTOR_SLIP_CONFIRM_MS) {
+            resid_ms[r]++;
+            continue;
+        }
+        int id = Slip_Locate(&rows[r], resid_filt[r], setpoints, speeds, applied, eligible);
+        if (id >= 0) {
+            slipping[id] = true;
+        }
+    }
+
+    // 2. 标志与牵引力限幅
+    for (int i = 0; i < 4; i++) {
+        if (slipping[i]) {
+            int mag = (applied[i] < 0) ? -applied[i] : applied[i];
+            motor_status[i] |= MOTOR_FLAG_SLIP;
+            if (!traction_enabled) {
+                slip_limit[i] = OUTPUT_LIMIT_FINE;  // 只报告打滑，不限幅
+                continue;
+            }
+            if (slip_limit[i] > mag) {
+                slip_limit[i] = mag;
+            }
+            slip_limit[i] -= slip_limit[i] >> 5;
+            if (slip_limit[i] < MOTOR_SLIP_LIMIT_MIN) {
+                slip_limit[i] = MOTOR_SLIP_LIMIT_MIN;
+            }
+        } else {
+            motor_status[i] &= (uint16_t)~MOTOR_FLAG_SLIP;
+            slip_limit[i] += MOTOR_SLIP_RECOVER;
+        }
+        if (!traction_enabled || slip_limit[i] > OUTPUT_LIMIT_FINE) {
+            slip_limit[i] = OUTPUT_LIMIT_FINE;
+        }
+    }
+}
+
+int MotorSlip_GetLimit(MotorID id) {
+    return slip_limit[id];
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 定位打滑轮
+ * @return 轴号，无符合条件的轴返回 -1
+ * @note 驱动打滑的轮沿自身输出方向超速，对残差的贡献 w_i·d_i·sign(u_i) 与残差同号
+ */
+static int Slip_Locate(const SlipRow *row, int32_t resid, const int setpoints[4],
+                       const int speeds[4], const int applied[4], const bool eligible[4]) {
+    int best = -1;
+    int32_t best_excess = 0;
+    int resid_sign = (resid < 0) ? -1 : 1;
+
+    for (int i = 0; i < 4; i++) {
+        if (row->w[i] == 0 || !eligible[i] || applied[i] == 0) {
+            continue;
+        }
+        int u_sign = (applied[i] < 0) ? -1 : 1;
+        if (row->w[i] * wheel_dir[i] * u_sign != resid_sign) {
+            continue;
+        }
+        int32_t excess = (int32_t)(speeds[i] - setpoints[i]) * u_sign;
+        if (best < 0 || excess > best_excess) {
+            best = i;
+            best_excess = excess;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file motor_slip.h
+ * @brief 基于四轮运动学一致性的打滑检测与牵引力控制
+ *
+ * @note 刚体底盘上四个轮速只有 2（差速）或 3（麦轮）个自由度，存在冗余约束：
+ *         差速（滑移转向）：A = C，B = D   （同侧前后轮纵向速度相同）
+ *         麦轮：           A + B = C + D   （前轴之和 = 后轴之和）
+ *       约束残差 r = Σ w_i·v_i 经一阶滤波后超过阈值即判定有轮打滑：
+ *         阈值 = MOTOR_SLIP_MIN_SPEED + ratio‰ × Σ|w_i·v_i|
+ *       单个约束无法区分是哪一轮，按驱动打滑“沿输出方向超速”的特征定位：
+ *       候选轮满足 sign(w_i·u_i) = sign(r)，取跟踪超速 (v_i - r_i)·sign(u_i) 最大者。
+ *       打滑轮置位 MOTOR_FLAG_SLIP；开启牵引力控制时，其输出限幅从当前输出起
+ *       每周期衰减 1/32，恢复抓地后以 MOTOR_SLIP_RECOVER 每周期回升，
+ *       经四轴协调去饱和后整车加速度受实际附着力限制。
+ *       轮速方向约定为“车轮正转 = 底盘前进”，不一致的轴用 MotorSlip_SetDir() 取反。
+ */
+
+#ifndef __MOTOR_SLIP_H
+#define __MOTOR_SLIP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOTOR_SLIP_MIN_SPEED       3     ///< 残差绝对阈值（计数/ms）
+#define MOTOR_SLIP_RATIO_DEFAULT   200   ///< 默认相对阈值（‰）
+#define MOTOR_SLIP_FILTER_SHIFT    3     ///< 残差一阶滤波 1/8（约8ms）
+#define MOTOR_SLIP_CONFIRM_MS      20    ///< 残差持续超限时间（ms）
+#define MOTOR_SLIP_RECOVER         (PWM_FINE_SCALE * 2)      ///< 限幅回升速率（Q6/ms）
+#define MOTOR_SLIP_LIMIT_MIN       (OUTPUT_LIMIT_FINE / 10)  ///< 牵引力控制最低限幅
+
+/**
+ * @brief 底盘运动学模型
+ */
+typedef enum {
+    MOTOR_SLIP_MODEL_NONE = 0,  ///< 关闭
+    MOTOR_SLIP_MODEL_SKID,      ///< 差速/滑移转向：A=C，B=D
+    MOTOR_SLIP_MODEL_MECANUM    ///< 麦克纳姆轮：A+B=C+D
+} MotorSlipModel;
+
+/**
+ * @brief 初始化（模型关闭，牵引力控制开启，方向均为正）
+ */
+void MotorSlip_Init(void);
+
+/**
+ * @brief 选择运动学模型
+ * @return 模型编号无效返回false
+ */
+bool MotorSlip_SetModel(MotorSlipModel model);
+
+/**
+ * @brief 设置相对阈值（‰）
+ */
+void MotorSlip_SetRatio(int32_t ratio);
+
+/**
+ * @brief 设置单轴方向（+1 / -1，正转不等于前进时取 -1）
+ */
+bool MotorSlip_SetDir(MotorID id, int32_t dir);
+
+/**
+ * @brief 开关牵引力控制（关闭时只上报标志）
+ */
+void MotorSlip_EnableTraction(bool enable);
+
+/**
+ * @brief 更新打滑检测（1kHz中断中调用）
+ * @param setpoints 各轴速度目标（计数/ms）
+ * @param speeds 各轴实际速度（计数/ms，编码器每周期增量）
+ * @param applied 各轴上周期实际输出（Q6）
+ * @param eligible 各轴是否参与（自整定/标定中的轴除外）
+ */
+void MotorSlip_Update(const int setpoints[4], const int speeds[4],
+                      const int applied[4], const bool eligible[4]);
+
+/**
+ * @brief 牵引力控制给出的输出限幅（Q6）
+ */
+int MotorSlip_GetLimit(MotorID id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOTOR_SLIP_H */
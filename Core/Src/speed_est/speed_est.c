@@ -0,0 +1,146 @@
+/**
+ * @file speed_est.c
+ * @brief α-β-γ 速度/加速度估计器（全整型实现）
+ *
+ * 位置状态不直接保存（累计计数会溢出 Q16），改为保存估计位置与实测位置之差 e = x - z：
+ *   e' = e + v + a/2 - Δz，r = -e'
+ *   e  = e' + α·r，v = v + a + β·r，a = a + 2γ·r
+ * 滑动窗口：sum += Δ - ring[head - N]，速度 = sum / N（N 为2的幂，移位代替除法）
+ */
+
+#include "speed_est.h"
+
+#define Q_ONE  (1 << SPEED_EST_FRAC_BITS)
+#define FEEDBACK_ONE  (1 << SPEED_EST_FEEDBACK_BITS)
+
+/**
+ * @brief 单轴估计器
+ */
+typedef struct {
+    int32_t e;        ///< 估计位置 - 实测位置（Q16）
+    int32_t v;        ///< 速度（计数/ms，Q16）
+    int32_t a;        ///< 加速度（计数/ms²，Q16）
+    int32_t alpha;    ///< α（Q16）
+    int32_t beta;     ///< β（Q16）
+    int32_t gamma2;   ///< 2γ（Q16）
+    int16_t ring[SPEED_EST_WINDOW_MAX];  ///< 最近的编码器增量
+    uint8_t head;     ///< 下一个写入位置
+    uint8_t win_shift;///< 窗口长度 = 1 << win_shift
+    int32_t win_sum;  ///< 窗口内增量之和
+    SpeedEstSource source;
+} SpeedEstAxis;
+
+static SpeedEstAxis est_axes[4];
+
+void SpeedEst_Init(void) {
+    for (int i = 0; i < 4; i++) {
+        est_axes[i].e = 0;
+        est_axes[i].v = 0;
+        est_axes[i].a = 0;
+        est_axes[i].source = SPEED_EST_SOURCE_RAW;
+        for (int k = 0; k < SPEED_EST_WINDOW_MAX; k++) {
+            est_axes[i].ring[k] = 0;
+        }
+        est_axes[i].head = 0;
+        SpeedEst_SetTheta((MotorID)i, SPEED_EST_THETA_DEFAULT);
+        SpeedEst_SetWindow((MotorID)i, SPEED_EST_WINDOW_DEFAULT);
+    }
+}
+
+bool SpeedEst_SetTheta(MotorID id, int32_t theta_permille) {
+    SpeedEstAxis *axis = &est_axes[id];
+
+    if (theta_permille < 0 || theta_permille >= 1000) {
+        return false;
+    }
+
+    int64_t t = ((int64_t)theta_permille * Q_ONE) / 1000;  // θ
+    int64_t u = Q_ONE - t;                                 // 1 - θ
+    int64_t t2 = (t * t) >> SPEED_EST_FRAC_BITS;
+    int64_t t3 = (t2 * t) >> SPEED_EST_FRAC_BITS;
+    int64_t u3 = (((u * u) >> SPEED_EST_FRAC_BITS) * u) >> SPEED_EST_FRAC_BITS;
+
+    axis->alpha = (int32_t)(Q_ONE - t3);
+    axis->beta = (int32_t)((3 * (Q_ONE - t2) * u) >> (SPEED_EST_FRAC_BITS + 1));
+    axis->gamma2 = (int32_t)u3;
+    return true;
+}
+
+bool SpeedEst_SetWindow(MotorID id, int32_t window_ms) {
+    SpeedEstAxis *axis = &est_axes[id];
+    uint8_t shift = 0;
+    int32_t sum = 0;
+
+    while ((1 << shift) < window_ms && (1 << shift) < SPEED_EST_WINDOW_MAX) {
+        shift++;
+    }
+    if ((1 << shift) != window_ms) {
+        return false;
+    }
+
+    // 按新窗口重算累加和（仅配置时执行一次）
+    for (int k = 1; k <= window_ms; k++) {
+        sum += axis->ring[(axis->head - k) & (SPEED_EST_WINDOW_MAX - 1)];
+    }
+    axis->win_sum = sum;
+    axis->win_shift = shift;
+    return true;
+}
+
+bool SpeedEst_SetSource(MotorID id, SpeedEstSource source) {
+    if (source > SPEED_EST_SOURCE_WINDOW) {
+        return false;
+    }
+    if (est_axes[id].source != source) {
+        PID_Bumpless(id);
+    }
+    est_axes[id].source = source;
+    return true;
+}
+
+void SpeedEst_Update(MotorID id, int delta) {
+    SpeedEstAxis *axis = &est_axes[id];
+
+    // 1. 预测
+    int32_t e_pred = axis->e + axis->v + axis->a / 2 - delta * Q_ONE;
+    int32_t r = -e_pred;
+
+    // 2. 修正
+    axis->e = e_pred + (int32_t)(((int64_t)axis->alpha * r) >> SPEED_EST_FRAC_BITS);
+    axis->v = axis->v + axis->a + (int32_t)(((int64_t)axis->beta * r) >> SPEED_EST_FRAC_BITS);
+    axis->a = axis->a + (int32_t)(((int64_t)axis->gamma2 * r) >> SPEED_EST_FRAC_BITS);
+
+    // 3. 滑动窗口：移出最旧的增量，移入本次增量
+    uint8_t out = (uint8_t)((axis->head - (1u << axis->win_shift)) & (SPEED_EST_WINDOW_MAX - 1));
+    axis->win_sum += delta - axis->ring[out];
+    axis->ring[axis->head] = (int16_t)delta;
+    axis->head = (uint8_t)((axis->head + 1u) & (SPEED_EST_WINDOW_MAX - 1));
+}
+
+int32_t SpeedEst_GetSpeedQ16(MotorID id) {
+    return est_axes[id].v;
+}
+
+int32_t SpeedEst_GetAccelQ16(MotorID id) {
+    return est_axes[id].a;
+}
+
+int32_t SpeedEst_GetWindowQ16(MotorID id) {
+    return (int32_t)(((int64_t)est_axes[id].win_sum * Q_ONE) >> est_axes[id].win_shift);
+}
+
+int SpeedEst_Feedback(MotorID id, int raw) {
+    int32_t v;
+
+    switch (est_axes[id].source) {
+        case SPEED_EST_SOURCE_ABG:
+            v = est_axes[id].v;
+            break;
+        case SPEED_EST_SOURCE_WINDOW:
+            v = SpeedEst_GetWindowQ16(id);
+            break;
+        default:
+            return raw * FEEDBACK_ONE;
+    }
+    return (int)((v + (Q_ONE / FEEDBACK_ONE / 2)) >> (SPEED_EST_FRAC_BITS - SPEED_EST_FEEDBACK_BITS));
+}
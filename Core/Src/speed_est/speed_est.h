@@ -0,0 +1,98 @@
+/**
+ * @file speed_est.h
+ * @brief α-β-γ 速度/加速度估计器（每轴一个，1kHz）
+ *
+ * @note 以编码器累计位置为观测量的三阶定常增益跟踪器（稳态卡尔曼的常用近似）：
+ *         预测：x' = x + v + a/2，v' = v + a，a' = a
+ *         残差：r  = z - x'
+ *         修正：x = x' + α·r，v = v' + β·r，a = a' + 2γ·r
+ *       增益由单一参数 θ（0~1）按临界阻尼配置：
+ *         α = 1 - θ³，β = 1.5·(1 - θ²)·(1 - θ)，γ = 0.5·(1 - θ)³
+ *       θ 越大越平滑、滞后越大；匀加速时稳态无偏，比滑动平均群延迟小。
+ *       另提供计算量更小的滑动窗口平均：环形缓冲保存最近 16 个增量，
+ *       窗口 1/2/4/8/16ms 可选，运行和 sum += Δ新 - Δ出窗，开销与窗口长度无关。
+ *       两者始终运行，反馈来源可逐轴在原始增量、估计值、窗口平均之间切换（无扰）。
+ */
+
+#ifndef __SPEED_EST_H
+#define __SPEED_EST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPEED_EST_FRAC_BITS      16     ///< 状态量小数位（Q16）
+#define SPEED_EST_FEEDBACK_BITS  8      ///< 速度环反馈小数位（Q8）
+#define SPEED_EST_THETA_DEFAULT  800    ///< 默认 θ（‰）
+#define SPEED_EST_WINDOW_MAX     16     ///< 滑动窗口最大长度（ms，2的幂）
+#define SPEED_EST_WINDOW_DEFAULT 8      ///< 默认窗口长度（ms）
+
+/**
+ * @brief 速度环反馈来源
+ */
+typedef enum {
+    SPEED_EST_SOURCE_RAW = 0,  ///< 编码器原始 1ms 增量
+    SPEED_EST_SOURCE_ABG,      ///< α-β-γ 估计速度
+    SPEED_EST_SOURCE_WINDOW    ///< 滑动窗口平均速度
+} SpeedEstSource;
+
+/**
+ * @brief 初始化（状态清零，θ 与窗口取默认值，反馈来源为原始增量）
+ */
+void SpeedEst_Init(void);
+
+/**
+ * @brief 设置单轴 θ
+ * @param theta_permille θ（‰，0~999）
+ * @return 超出范围返回false
+ */
+bool SpeedEst_SetTheta(MotorID id, int32_t theta_permille);
+
+/**
+ * @brief 设置单轴滑动窗口长度
+ * @param window_ms 1/2/4/8/16
+ * @return 不是允许的长度返回false
+ */
+bool SpeedEst_SetWindow(MotorID id, int32_t window_ms);
+
+/**
+ * @brief 选择单轴速度环反馈来源
+ */
+bool SpeedEst_SetSource(MotorID id, SpeedEstSource source);
+
+/**
+ * @brief 输入一个周期的编码器增量，更新估计（每 1ms 调用一次）
+ */
+void SpeedEst_Update(MotorID id, int delta);
+
+/**
+ * @brief 估计速度（计数/ms，Q16）
+ */
+int32_t SpeedEst_GetSpeedQ16(MotorID id);
+
+/**
+ * @brief 估计加速度（计数/ms²，Q16）
+ */
+int32_t SpeedEst_GetAccelQ16(MotorID id);
+
+/**
+ * @brief 滑动窗口平均速度（计数/ms，Q16）
+ */
+int32_t SpeedEst_GetWindowQ16(MotorID id);
+
+/**
+ * @brief 速度环反馈值（计数/ms，Q8）：按所选来源返回原始增量，或估计/窗口平均速度
+ * @note 保留小数部分：估计值取整后送入PID会留下最多 ±0.5 计数/ms 的稳态偏差
+ *       （如目标1、实际0.6时估计取整为1，误差与积分均为0）；原始增量的小数为0
+ */
+int SpeedEst_Feedback(MotorID id, int raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPEED_EST_H */
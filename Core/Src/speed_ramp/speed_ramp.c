@@ -1,8 +1,9 @@
 /* speed_ramp.c -------------------------------------------------*
  * 用户仅需修改 2 个参数:
- *   1) TIMER_FREQ_HZ   —— 定时器真正的中断频率 (Hz)
- *   2) ACC_RPM_PER_SEC —— 允许的最大加速度 (RPM / s)
- * 其他常量全部由这两项自动推导，保持整数运算。
+ *   1) TIMER_FREQ_HZ   —— 步长分频系数（不是中断频率）
+ *   2) ACC_RPM_PER_SEC —— 步长基准 (RPM)
+ * 每个周期目标最多变化 STEP_MRPM = ACC_RPM_PER_SEC × 1000 / TIMER_FREQ_HZ mRPM，
+ * 实际最大加速度 = STEP_MRPM × RAMP_TICK_HZ / 1000 (RPM/s)，保持整数运算。
  *---------------------------------------------------------------*/
 
 #include <stdint.h>
@@ -11,10 +12,13 @@
 #include "F:\\Project\\DSB1\\Core\\Src\\motor\\motor_pid.h"
 
 /*=================== 用户可调宏 ===================*/
-#define TIMER_FREQ_HZ      10      /* 周期（毫秒） */
-#define ACC_RPM_PER_SEC    1         /* 每秒最多增加的 RPM */
+#define TIMER_FREQ_HZ      10      /* 步长分频系数 */
+#define ACC_RPM_PER_SEC    1         /* 步长基准 RPM */
 /*==================================================*/
 
+/* 实际调用频率：TIM7 中断，72MHz / (PSC 7199 + 1) / (ARR 9 + 1) = 1kHz */
+#define RAMP_TICK_HZ       1000
+
 /*------- 内部派生常量 (勿改) -----------------------*/
 #define SCALE_MRPM   1000                                    /* 1 RPM = 1000 mRPM */
 #define STEP_MRPM  ((ACC_RPM_PER_SEC * SCALE_MRPM            \
@@ -24,6 +28,9 @@
 /* 高分辨率目标速度 (单位: mRPM) --------------------*/
 static int32_t target_mrpm[4] = {0};
 
+/* 当前斜坡加速度 (单位: RPM/s，数值上等于 mRPM/ms) ---*/
+static int32_t ramp_accel[4] = {0};
+
 /*=================== 斜坡更新 =====================*/
 void SpeedRamp_Update(void)
 {
@@ -46,7 +53,15 @@ void SpeedRamp_Update(void)
             cur_m = goal_m;
         }
 
+        ramp_accel[i]    = trapezoidEnabled             /* 供加速度前馈，阶跃不前馈 */
+                         ? (cur_m - target_mrpm[i]) * RAMP_TICK_HZ / SCALE_MRPM : 0;
         target_mrpm[i]   = cur_m;                     /* 保存高分辨率 */
         target_speeds[i] = (int16_t)(cur_m / SCALE_MRPM); /* 输出整 RPM 供 PID */
     }
 }
+
+/*=================== 加速度查询 ===================*/
+int32_t SpeedRamp_GetAccel(uint8_t i)
+{
+    return (i < 4u) ? ramp_accel[i] : 0;
+}
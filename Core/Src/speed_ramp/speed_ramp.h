@@ -9,4 +9,7 @@
 /* 在定时器回调里调用 */
 void SpeedRamp_Update(void);
 
+/* 当前斜坡加速度 (RPM/s)；阶跃模式或已收敛时为 0 */
+int32_t SpeedRamp_GetAccel(uint8_t i);
+
 #endif /* __SPEED_RAMP_H_ */
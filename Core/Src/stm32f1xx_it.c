@@ -23,6 +23,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "motor/motor_pid.h"
+#include "motor/ax_motor.h"
+#include "current_loop/current_loop.h"
 #include "usart.h"
 #include "motor_frame/uart2_motor_frame.h"
 #include "uart2_dma_tx\uart2_dma_tx.h"
@@ -286,6 +288,22 @@ void TIM7_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles TIM1 update interrupt (motor direction sequencing).
+  */
+void TIM1_UP_IRQHandler(void)
+{
+    Motor_PwmUpdate_IRQHandler();
+}
+
+/**
+  * @brief This function handles ADC1 and ADC2 global interrupts (current loop).
+  */
+void ADC1_2_IRQHandler(void)
+{
+    CurrentLoop_IRQHandler();
+}
+
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
     if (huart->Instance == USART2)
@@ -0,0 +1,224 @@
+/**
+ * @file sysid.c
+ * @brief 系统辨识：PRBS/扫频激励与同步采集（全整型实现）
+ */
+
+#include "sysid.h"
+#include "../fixmath/fixmath.h"
+#include "../autotune/autotune.h"
+#include "../motor_cal/motor_cal.h"
+#include "../bode/bode.h"
+#include "../motor_cmd/motor_cmd.h"
+#include "../uart2_dma_tx/uart2_dma_tx.h"
+
+#define SYSID_NONE       0xFFu                  ///< 无轴运行
+#define PRBS_SEED        0x7FFFu                ///< LFSR 初值（非零）
+#define PHASE_PER_DHZ    (FIX_PHASE_PER_HZ_1KHZ / 10u)  ///< 0.1Hz 对应的相位增量
+#define UPLOAD_NONE      0xFFFFu
+
+/**
+ * @brief 采集点
+ */
+typedef struct {
+    int16_t duty;     ///< 平均占空比（控制器域，Q3）
+    int16_t delta;    ///< 编码器增量之和
+} SysidSample;
+
+static SysidSample sysid_buf[SYSID_CAPACITY];
+static int32_t sysid_params[SYSID_PARAM_COUNT];
+
+static uint8_t active_id = SYSID_NONE;   ///< 运行中的轴
+static uint8_t captured_id;              ///< 缓冲区数据所属的轴
+static uint16_t sample_count;            ///< 已采集点数
+static uint32_t tick;                    ///< 激励周期计数
+static uint16_t lfsr;                    ///< PRBS 移位寄存器
+static uint32_t phase;                   ///< 扫频相位
+static int32_t acc_duty;                 ///< 抽取累加：占空比（Q6）
+static int32_t acc_delta;                ///< 抽取累加：增量
+static uint8_t acc_n;                    ///< 抽取累加点数
+static uint16_t upload_pos = UPLOAD_NONE;///< 上传进度
+
+/* 私有函数声明 */
+static int32_t Sysid_Excitation(void);
+static void Sysid_Finish(void);
+
+void Sysid_Init(void) {
+    sysid_params[SYSID_PARAM_SIGNAL] = SYSID_SIGNAL_PRBS;
+    sysid_params[SYSID_PARAM_CLOSED] = 0;
+    sysid_params[SYSID_PARAM_AMPLITUDE] = 200;
+    sysid_params[SYSID_PARAM_OFFSET] = 300;
+    sysid_params[SYSID_PARAM_PRBS_HOLD] = 4;
+    sysid_params[SYSID_PARAM_CHIRP_F0] = 10;     // 1Hz
+    sysid_params[SYSID_PARAM_CHIRP_F1] = 1000;   // 100Hz
+    sysid_params[SYSID_PARAM_LENGTH] = SYSID_CAPACITY;
+    sysid_params[SYSID_PARAM_DECIM] = 1;
+    active_id = SYSID_NONE;
+    captured_id = 0;
+    sample_count = 0;
+    upload_pos = UPLOAD_NONE;
+}
+
+bool Sysid_SetParam(SysidParam param, int32_t value) {
+    int32_t lo;
+    int32_t hi;
+
+    if (active_id != SYSID_NONE) {
+        return false;
+    }
+    switch (param) {
+        case SYSID_PARAM_SIGNAL:    lo = 0; hi = SYSID_SIGNAL_CHIRP; break;
+        case SYSID_PARAM_CLOSED:    lo = 0; hi = 1; break;
+        case SYSID_PARAM_AMPLITUDE: lo = 0; hi = OUTPUT_LIMIT; break;
+        case SYSID_PARAM_OFFSET:    lo = -OUTPUT_LIMIT; hi = OUTPUT_LIMIT; break;
+        case SYSID_PARAM_PRBS_HOLD: lo = 1; hi = 255; break;
+        case SYSID_PARAM_CHIRP_F0:  lo = 0; hi = 5000; break;
+        case SYSID_PARAM_CHIRP_F1:  lo = 0; hi = 5000; break;
+        case SYSID_PARAM_LENGTH:    lo = 1; hi = SYSID_CAPACITY; break;
+        case SYSID_PARAM_DECIM:     lo = 1; hi = SYSID_DECIM_MAX; break;
+        default: return false;
+    }
+    if (value < lo || value > hi) {
+        return false;
+    }
+    sysid_params[param] = value;
+    return true;
+}
+
+bool Sysid_Start(MotorID id) {
+    if (active_id != SYSID_NONE || Autotune_IsActive(id) || MotorCal_IsActive(id) ||
+        Bode_IsActive(id)) {
+        return false;
+    }
+    sample_count = 0;
+    tick = 0;
+    lfsr = PRBS_SEED;
+    phase = 0;
+    acc_duty = 0;
+    acc_delta = 0;
+    acc_n = 0;
+    upload_pos = UPLOAD_NONE;
+    active_id = (uint8_t)id;
+    captured_id = (uint8_t)id;
+    motor_status[id] |= MOTOR_FLAG_SYSID;
+    PID_Bumpless(id);
+    return true;
+}
+
+void Sysid_Abort(void) {
+    if (active_id != SYSID_NONE) {
+        Sysid_Finish();
+    }
+}
+
+bool Sysid_IsActive(MotorID id) {
+    return active_id == (uint8_t)id;
+}
+
+bool Sysid_IsClosedLoop(void) {
+    return sysid_params[SYSID_PARAM_CLOSED] != 0;
+}
+
+int Sysid_Update(MotorID id, int pid_output) {
+    int32_t out = Sysid_Excitation() * PWM_FINE_SCALE;
+
+    (void)id;
+    if (sysid_params[SYSID_PARAM_CLOSED] != 0) {
+        out += pid_output;
+    } else {
+        out += sysid_params[SYSID_PARAM_OFFSET] * PWM_FINE_SCALE;
+    }
+    if (out > OUTPUT_LIMIT_FINE) {
+        out = OUTPUT_LIMIT_FINE;
+    } else if (out < -OUTPUT_LIMIT_FINE) {
+        out = -OUTPUT_LIMIT_FINE;
+    }
+    tick++;
+    return (int)out;
+}
+
+void Sysid_Record(MotorID id, int fine, int delta) {
+    if (active_id != (uint8_t)id) {
+        return;
+    }
+
+    acc_duty += fine;
+    acc_delta += delta;
+    if (++acc_n < sysid_params[SYSID_PARAM_DECIM]) {
+        return;
+    }
+
+    // Q6 均值 -> Q3
+    sysid_buf[sample_count].duty = (int16_t)((acc_duty / acc_n) >> (PWM_FRAC_BITS - 3));
+    sysid_buf[sample_count].delta = (int16_t)acc_delta;
+    acc_duty = 0;
+    acc_delta = 0;
+    acc_n = 0;
+
+    if (++sample_count >= sysid_params[SYSID_PARAM_LENGTH]) {
+        Sysid_Finish();
+    }
+}
+
+bool Sysid_Upload(void) {
+    if (active_id != SYSID_NONE || sample_count == 0u || upload_pos != UPLOAD_NONE) {
+        return false;
+    }
+    if (!Uart2DmaSendReply(MOTOR_CMD_SYSID, captured_id, 2, sample_count)) {
+        return false;
+    }
+    upload_pos = 0;
+    return true;
+}
+
+void Sysid_Task(void) {
+    while (upload_pos < sample_count) {
+        const SysidSample *s = &sysid_buf[upload_pos];
+        int32_t value = (int32_t)(((uint32_t)(uint16_t)s->duty << 16) | (uint16_t)s->delta);
+
+        if (!Uart2DmaSendReply(MOTOR_CMD_SYSID_DATA, captured_id, upload_pos, value)) {
+            return;  // 队列满，下个周期继续
+        }
+        upload_pos++;
+    }
+    upload_pos = UPLOAD_NONE;
+}
+
+/* 私有函数 ----------------------------------------------------------------*/
+
+/**
+ * @brief 当前周期的激励值（占空比）
+ */
+static int32_t Sysid_Excitation(void) {
+    int32_t amp = sysid_params[SYSID_PARAM_AMPLITUDE];
+
+    if (sysid_params[SYSID_PARAM_SIGNAL] == SYSID_SIGNAL_CHIRP) {
+        // 线性扫频：相位增量随时间线性增加
+        uint32_t total = (uint32_t)sysid_params[SYSID_PARAM_LENGTH] *
+                         (uint32_t)sysid_params[SYSID_PARAM_DECIM];
+        uint32_t inc0 = (uint32_t)sysid_params[SYSID_PARAM_CHIRP_F0] * PHASE_PER_DHZ;
+        uint32_t inc1 = (uint32_t)sysid_params[SYSID_PARAM_CHIRP_F1] * PHASE_PER_DHZ;
+        uint32_t inc = inc0 + (uint32_t)(((int64_t)((int32_t)(inc1 - inc0)) * tick) / total);
+
+        phase += inc;
+        return (amp * Fix_SinQ15(phase)) >> 15;
+    }
+
+    // PRBS：每 hold 个周期移位一次
+    if (tick != 0u && (tick % (uint32_t)sysid_params[SYSID_PARAM_PRBS_HOLD]) == 0u) {
+        uint16_t bit = (uint16_t)(((lfsr >> 14) ^ (lfsr >> 13)) & 1u);
+        lfsr = (uint16_t)(((lfsr << 1) | bit) & 0x7FFFu);
+    }
+    return (lfsr & 1u) ? amp : -amp;
+}
+
+/**
+ * @brief 结束辨识并上报点数
+ */
+static void Sysid_Finish(void) {
+    MotorID id = (MotorID)active_id;
+
+    active_id = SYSID_NONE;
+    motor_status[id] &= (uint16_t)~MOTOR_FLAG_SYSID;
+    PID_Bumpless(id);
+    Uart2DmaSendReply(MOTOR_CMD_SYSID, (uint8_t)id, 0, sample_count);
+}
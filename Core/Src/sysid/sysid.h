@@ -0,0 +1,116 @@
+/**
+ * @file sysid.h
+ * @brief 系统辨识：PRBS/扫频激励与控制周期同步采集
+ *
+ * @note 单轴运行（共用一块采集缓冲），由 Update_Motors() 调用：
+ *       - 开环：输出 = 偏置 + 激励，PID状态冻结
+ *       - 闭环：输出 = PID输出 + 激励，PID照常运行（激励不计入抗饱和）
+ *       激励：
+ *       - PRBS：15 位最长线性反馈移位寄存器（x^15 + x^14 + 1），
+ *         每位保持 hold 个周期，输出 ±幅值
+ *       - 扫频：线性调频正弦，频率在采集时长内由 f0 线性增加到 f1
+ *       采集：每 decim 个周期记录一点：平均占空比（控制器域，Q3）与编码器增量之和。
+ *       采集满后自动结束，以 MOTOR_CMD_SYSID 应答 idx0 上报点数；
+ *       上传时先应答 idx2 点数，再以 MOTOR_CMD_SYSID_DATA 逐点上报：
+ *         idx = 序号，value = (占空比Q3 << 16) | (uint16)增量
+ *       记录的是线性化/电压补偿之前的控制器输出，辨识得到的即控制器“看到”的对象。
+ *       主机端拟合工具见 Tools/sysid_fit.py。
+ */
+
+#ifndef __SYSID_H
+#define __SYSID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../motor/motor_pid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYSID_CAPACITY     2048   ///< 采集缓冲点数（每点 4 字节）
+#define SYSID_DECIM_MAX    16     ///< 最大抽取比
+
+/**
+ * @brief 激励类型
+ */
+typedef enum {
+    SYSID_SIGNAL_PRBS = 0,  ///< 伪随机二进制序列
+    SYSID_SIGNAL_CHIRP      ///< 线性扫频正弦
+} SysidSignal;
+
+/**
+ * @brief 可调参数编号（MOTOR_CMD_SYSID_PARAM 的 idx）
+ */
+typedef enum {
+    SYSID_PARAM_SIGNAL = 0,   ///< 激励类型（SysidSignal）
+    SYSID_PARAM_CLOSED,       ///< 0 = 开环，1 = 闭环
+    SYSID_PARAM_AMPLITUDE,    ///< 激励幅值（占空比，0~1000）
+    SYSID_PARAM_OFFSET,       ///< 开环偏置（占空比，±1000）
+    SYSID_PARAM_PRBS_HOLD,    ///< PRBS 每位保持周期数（1~255）
+    SYSID_PARAM_CHIRP_F0,     ///< 扫频起始频率（0.1Hz）
+    SYSID_PARAM_CHIRP_F1,     ///< 扫频终止频率（0.1Hz，≤ 5000）
+    SYSID_PARAM_LENGTH,       ///< 采集点数（1~SYSID_CAPACITY）
+    SYSID_PARAM_DECIM,        ///< 抽取比（1~SYSID_DECIM_MAX）
+    SYSID_PARAM_COUNT
+} SysidParam;
+
+/**
+ * @brief 初始化（默认：开环 PRBS，幅值 200，偏置 300，保持 4 周期，采集 2048 点）
+ */
+void Sysid_Init(void);
+
+/**
+ * @brief 修改参数（运行中不可修改）
+ * @return 参数编号无效、数值越界或正在运行返回false
+ */
+bool Sysid_SetParam(SysidParam param, int32_t value);
+
+/**
+ * @brief 在单轴上启动辨识
+ * @return 已有轴在运行、该轴正在自整定/标定/扫频返回false
+ */
+bool Sysid_Start(MotorID id);
+
+/**
+ * @brief 中止辨识（已采集的数据保留，可上传）
+ */
+void Sysid_Abort(void);
+
+bool Sysid_IsActive(MotorID id);
+
+/**
+ * @brief 当前配置是否为闭环辨识
+ */
+bool Sysid_IsClosedLoop(void);
+
+/**
+ * @brief 叠加激励（1kHz中断中调用）
+ * @param pid_output 闭环模式下PID的输出（Q6），开环时忽略
+ * @return 该轴输出（Q6，±OUTPUT_LIMIT_FINE）
+ */
+int Sysid_Update(MotorID id, int pid_output);
+
+/**
+ * @brief 记录一个控制周期（整条输出链路之后调用）
+ * @param fine 实际施加的控制器输出（Q6）
+ * @param delta 本周期编码器增量
+ */
+void Sysid_Record(MotorID id, int fine, int delta);
+
+/**
+ * @brief 请求上传采集数据
+ * @return 正在运行、正在上传或无数据返回false
+ */
+bool Sysid_Upload(void);
+
+/**
+ * @brief 上传处理（每个控制周期调用，按应答队列余量逐条发送）
+ */
+void Sysid_Task(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYSID_H */
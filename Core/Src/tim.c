@@ -400,6 +400,9 @@ void HAL_TIM_PWM_MspInit(TIM_HandleTypeDef* tim_pwmHandle)
     /* TIM1 clock enable */
     __HAL_RCC_TIM1_CLK_ENABLE();
   /* USER CODE BEGIN TIM1_MspInit 1 */
+    /* 更新中断用于电机换向时序（ax_motor.c），中断使能位按需开关 */
+    HAL_NVIC_SetPriority(TIM1_UP_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(TIM1_UP_IRQn);
 
   /* USER CODE END TIM1_MspInit 1 */
   }
@@ -596,6 +599,7 @@ void HAL_TIM_PWM_MspDeInit(TIM_HandleTypeDef* tim_pwmHandle)
     /* Peripheral clock disable */
     __HAL_RCC_TIM1_CLK_DISABLE();
   /* USER CODE BEGIN TIM1_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(TIM1_UP_IRQn);
 
   /* USER CODE END TIM1_MspDeInit 1 */
   }
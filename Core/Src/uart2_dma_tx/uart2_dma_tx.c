@@ -5,8 +5,18 @@
 //   Target speed: 4×int16 -> uart_set_speed[4]
 //   Odometer    : 4×int32 -> s_position[4]
 //   Real speed  : 4×int32 -> real_speeds[4]
+//   Status      : 4×uint16-> motor_status[4] (MOTOR_FLAG_*)
+//   Current     : 4×int16 -> motor current, mA (PWM‑synchronous ADC sample)
+//   Bus voltage : 1×uint16-> Vbus, mV
+//   Vbus comp   : 1×uint16-> supply compensation gain, ‰ (1000 = none)
+//   Window speed: 4×int32 -> sliding-window average speed, counts/ms Q8
+//   Load est.   : 4×int16 -> disturbance-observer load estimate, PWM
 //   Tail        : 1 byte  -> '!'
-// Total length  : 42 bytes
+// Total length  : 86 bytes
+//
+// Reply frame (little‑endian, 10 bytes, same layout as the '$' command frame):
+//   '$' | cmd u8 | axis u8 | idx u16 | value int32 | '!'
+//   Queued by Uart2DmaSendReply() and sent back‑to‑back whenever DMA is idle.
 // ----------------------------------------------------------------------------
 // Usage:
 //   • CubeMX 生成 USART2 (DMA1_Channel7) 与 TIM8 更新中断。
@@ -25,14 +35,41 @@
 #include "F:\Project\DSB1\Core\Src\motor_frame\uart2_motor_frame.h"
 #include "F:\Project\DSB1\Core\Src\motor\ax_motor.h"
 #include "F:\Project\DSB1\Core\Src\motor\motor_pid.h"
+#include "../adc_sense/adc_sense.h"
+#include "../vbus_comp/vbus_comp.h"
+#include "../speed_est/speed_est.h"
+#include "../motor_dob/motor_dob.h"
 
 
-#define TX_PKT_LEN  42                         // 1 + 8 + 16 + 16 + 1
+#define TX_PKT_LEN  86                         // 1 + 8 + 16 + 16 + 8 + 8 + 2 + 2 + 16 + 8 + 1
+
+#define REPLY_LEN        10                    // 1 + 1 + 1 + 2 + 4 + 1
+#define REPLY_QUEUE_LEN  32                    // 应答队列深度（帧）
 
 static uint8_t txBuf[TX_PKT_LEN];              // DMA 发送缓冲区
 static volatile bool txBusy = false;           // DMA 正忙标志
 
-/* 封装 42‑byte 数据帧到 txBuf */
+static uint8_t replyQueue[REPLY_QUEUE_LEN][REPLY_LEN]; // 应答帧环形队列
+static uint8_t replyHead = 0;                  // 下一个待发送
+static uint8_t replyTail = 0;                  // 下一个写入位置
+static uint8_t replyBuf[REPLY_LEN];            // 正在发送的应答帧
+
+/* 若 DMA 空闲且队列非空，则发送一帧应答 */
+static void SendNextReply(void)
+{
+    if (txBusy || replyHead == replyTail) {
+        return;
+    }
+
+    memcpy(replyBuf, replyQueue[replyHead], REPLY_LEN);
+    replyHead = (uint8_t)((replyHead + 1u) % REPLY_QUEUE_LEN);
+
+    if (HAL_UART_Transmit_DMA(&huart2, replyBuf, REPLY_LEN) == HAL_OK) {
+        txBusy = true;
+    }
+}
+
+/* 封装 86‑byte 数据帧到 txBuf */
 static void PreparePacket(void)
 {
     uint8_t *p = txBuf;
@@ -59,6 +96,44 @@ static void PreparePacket(void)
         p += sizeof(int32_t);
     }
 
+    // 4. 状态标志 4×uint16
+    for (int i = 0; i < 4; ++i) {
+        uint16_t st = motor_status[i];
+        memcpy(p, &st, sizeof(uint16_t));
+        p += sizeof(uint16_t);
+    }
+
+    // 5. 电流 4×int16（mA）
+    for (int i = 0; i < 4; ++i) {
+        int16_t cur = (int16_t)AdcSense_GetCurrent((MotorID)i);
+        memcpy(p, &cur, sizeof(int16_t));
+        p += sizeof(int16_t);
+    }
+
+    // 6. 母线电压 uint16（mV）
+    uint16_t vbus = (uint16_t)AdcSense_GetVbus();
+    memcpy(p, &vbus, sizeof(uint16_t));
+    p += sizeof(uint16_t);
+
+    // 7. 母线电压补偿增益 uint16（‰）
+    uint16_t gain = (uint16_t)((VbusComp_GetGain() * 1000u) >> 16);
+    memcpy(p, &gain, sizeof(uint16_t));
+    p += sizeof(uint16_t);
+
+    // 8. 滑动窗口平均速度 4×int32（Q8，避免 20Hz 抽样 1ms 增量的混叠）
+    for (int i = 0; i < 4; ++i) {
+        int32_t w = SpeedEst_GetWindowQ16((MotorID)i) / 256;
+        memcpy(p, &w, sizeof(int32_t));
+        p += sizeof(int32_t);
+    }
+
+    // 9. 负载扰动估计 4×int16（PWM）
+    for (int i = 0; i < 4; ++i) {
+        int16_t d = (int16_t)MotorDob_GetEstimate((MotorID)i);
+        memcpy(p, &d, sizeof(int16_t));
+        p += sizeof(int16_t);
+    }
+
     *p++ = '!';                                // 帧尾
 
 }
@@ -83,11 +158,35 @@ void Uart2DmaSendPacket(void)
     }
 }
 
+/* 把一帧应答放入队列；队列满时丢弃并返回 false */
+bool Uart2DmaSendReply(uint8_t cmd, uint8_t axis, uint16_t idx, int32_t value)
+{
+    uint8_t next = (uint8_t)((replyTail + 1u) % REPLY_QUEUE_LEN);
+    if (next == replyHead) {
+        return false;                          // 队列满
+    }
+
+    uint8_t *p = replyQueue[replyTail];
+    *p++ = '$';
+    *p++ = cmd;
+    *p++ = axis;
+    memcpy(p, &idx, sizeof(uint16_t));
+    p += sizeof(uint16_t);
+    memcpy(p, &value, sizeof(int32_t));
+    p += sizeof(int32_t);
+    *p = '!';
+    replyTail = next;
+
+    SendNextReply();
+    return true;
+}
+
 /* HAL 回调：发送完成 */
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
     if (huart->Instance == USART2) {
         txBusy = false;
+        SendNextReply();
     }
 }
 
@@ -1,6 +1,13 @@
 /* uart2_dma_tx.h — public interface for uart2_dma_tx.c
  * ----------------------------------------------------
- * Provides a simple API to send a 42‑byte framed packet over USART2 using DMA.
+ * Provides a simple API to send an 86‑byte framed packet over USART2 using DMA.
+ *
+ * Packet layout (little‑endian, see uart2_dma_tx.c):
+ *   '#' | target 4×i16 | odometer 4×i32 | speed 4×i32 | status 4×u16
+ *       | current 4×i16 mA | Vbus u16 mV | comp gain u16 ‰
+ *       | window speed 4×i32 Q8 | load est. 4×i16 | '!'
+ *   = 1 + 8 + 16 + 16 + 8 + 8 + 2 + 2 + 16 + 8 + 1 = 86 bytes
+ * Reply frames are 10 bytes: '$' | cmd u8 | axis u8 | idx u16 | value i32 | '!'
  */
 
 #ifndef UART2_DMA_TX_H
@@ -24,6 +31,13 @@ extern "C" {
  */
 void Uart2DmaSendPacket(void);
 
+/**
+ * @brief  Queue one 10‑byte reply frame ('$' cmd axis idx value '!') for
+ *         transmission after the current DMA transfer.
+ * @retval false if the reply queue is full and the frame was dropped.
+ */
+bool Uart2DmaSendReply(uint8_t cmd, uint8_t axis, uint16_t idx, int32_t value);
+
 #ifdef __cplusplus
 }
 #endif
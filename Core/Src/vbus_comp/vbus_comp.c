@@ -0,0 +1,93 @@
+/**
+ * @file vbus_comp.c
+ * @brief 母线电压前馈补偿（全整型实现）
+ *
+ * 原理：
+ * 1. vf += (Vbus - vf) / 16        （vf 为 Q4 mV）
+ * 2. gain = (V标称 << 16) / vf      （Q16，限幅 0.5~2.0）；
+ *    未设置标称电压时，开启补偿后的首个有效周期锁存 vf 作为标称（增益从1开始）
+ * 3. duty' = fine · gain >> 16
+ */
+
+#include "vbus_comp.h"
+#include "../adc_sense/adc_sense.h"
+#include "../motor/motor_pid.h"
+
+#define GAIN_ONE  65536u
+
+static bool comp_enabled = false;                      ///< 补偿开关
+static uint32_t nominal_mv = VBUS_COMP_NOMINAL_AUTO;   ///< 标称电压（mV），AUTO = 待锁存
+static uint32_t vbus_filt = 0;                         ///< 滤波后的母线电压（Q4 mV），0 = 未初始化
+static volatile uint32_t comp_gain = GAIN_ONE;         ///< 当前增益（Q16）
+
+void VbusComp_Init(void) {
+    comp_enabled = false;
+    nominal_mv = VBUS_COMP_NOMINAL_AUTO;
+    vbus_filt = 0;
+    comp_gain = GAIN_ONE;
+}
+
+void VbusComp_Enable(bool enable) {
+    comp_enabled = enable;
+    if (!enable) {
+        comp_gain = GAIN_ONE;
+    }
+}
+
+bool VbusComp_SetNominal(uint32_t mv) {
+    if (mv < VBUS_COMP_MIN_MV || mv > 0xFFFFu) {
+        return false;
+    }
+    nominal_mv = mv;
+    return true;
+}
+
+void VbusComp_Update(void) {
+    uint32_t vbus = AdcSense_GetVbus();
+
+    if (vbus < VBUS_COMP_MIN_MV) {
+        return;  // 采样无效或电池已断开，保持上一增益
+    }
+
+    // 1. 一阶滤波（首次有效采样直接装载）
+    if (vbus_filt == 0u) {
+        vbus_filt = vbus << VBUS_COMP_FILTER_SHIFT;
+    } else {
+        vbus_filt = vbus_filt - (vbus_filt >> VBUS_COMP_FILTER_SHIFT) + vbus;
+    }
+
+    if (!comp_enabled) {
+        return;
+    }
+    if (nominal_mv == VBUS_COMP_NOMINAL_AUTO) {
+        nominal_mv = vbus_filt >> VBUS_COMP_FILTER_SHIFT;  // 锁存当前电压，开启时输出不跳变
+    }
+
+    // 2. gain = V标称 / V实测（vbus_filt 为 Q4，分子同样左移4位）
+    uint32_t gain = (uint32_t)(((uint64_t)nominal_mv << (16 + VBUS_COMP_FILTER_SHIFT)) / vbus_filt);
+    if (gain < VBUS_COMP_GAIN_MIN) {
+        gain = VBUS_COMP_GAIN_MIN;
+    } else if (gain > VBUS_COMP_GAIN_MAX) {
+        gain = VBUS_COMP_GAIN_MAX;
+    }
+    comp_gain = gain;
+}
+
+int VbusComp_Apply(int fine) {
+    int32_t duty = (int32_t)(((int64_t)fine * comp_gain) >> 16);
+
+    if (duty > OUTPUT_LIMIT_FINE) {
+        duty = OUTPUT_LIMIT_FINE;
+    } else if (duty < -OUTPUT_LIMIT_FINE) {
+        duty = -OUTPUT_LIMIT_FINE;
+    }
+    return (int)duty;
+}
+
+int VbusComp_Remove(int fine) {
+    return (int)(((int64_t)fine << 16) / (int64_t)comp_gain);
+}
+
+uint32_t VbusComp_GetGain(void) {
+    return comp_gain;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file vbus_comp.h
+ * @brief 母线电压前馈补偿（占空比按 V标称/V实测 缩放）
+ *
+ * @note 电机端电压 ≈ 占空比 × Vbus，电池放电时同一输出对应的转速下降，
+ *       相当于环路增益随电压变化。每个控制周期对母线电压做一阶滤波，
+ *       计算 gain = V标称 / V实测（Q16），在查表线性化之后、Σ-Δ抖动之前相乘：
+ *       查找表（含死区 lut[0] 与起转占空比）是标定电压下的占空比，
+ *       整体按电压缩放后控制器看到的“等效电压”与电池状态无关。
+ *       补偿后限幅时，最终占空比经 VbusComp_Remove() 与 MotorCal_Unlinearize()
+ *       逆换算回控制器域，供积分抗饱和。
+ *       启用电流环的轴不做补偿（电流环本身抑制电压扰动）。
+ *       默认关闭：标称电压应为整定PID时的电压，固定默认值与实际不符时
+ *       开机即引入增益偏差。未设置标称电压时，开启补偿后锁存当时的
+ *       母线电压作为标称，此后的输出相对开启时刻的电压保持不变。
+ */
+
+#ifndef __VBUS_COMP_H
+#define __VBUS_COMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VBUS_COMP_NOMINAL_AUTO     0       ///< 标称电压未设置：开启后锁存首个有效电压
+#define VBUS_COMP_MIN_MV           5000    ///< 低于此值视为无效采样，增益保持上一值
+#define VBUS_COMP_GAIN_MIN         32768   ///< 增益下限（Q16，0.5）
+#define VBUS_COMP_GAIN_MAX         131072  ///< 增益上限（Q16，2.0）
+#define VBUS_COMP_FILTER_SHIFT     4       ///< 一阶滤波系数 1/16（1kHz 下时间常数约16ms）
+
+/**
+ * @brief 初始化（默认关闭，标称电压待锁存，增益为1）
+ */
+void VbusComp_Init(void);
+
+/**
+ * @brief 开关补偿（关闭时增益固定为1）
+ */
+void VbusComp_Enable(bool enable);
+
+/**
+ * @brief 设置标称电压（整定PID时的母线电压）
+ * @param mv 标称电压（mV），须在 VBUS_COMP_MIN_MV 以上
+ * @return 超出范围返回false
+ */
+bool VbusComp_SetNominal(uint32_t mv);
+
+/**
+ * @brief 采样母线电压并更新增益（每个控制周期调用一次）
+ */
+void VbusComp_Update(void);
+
+/**
+ * @brief 对精细占空比施加补偿
+ * @param fine 线性化后的占空比（Q6）
+ * @return 补偿后的占空比（Q6，限幅到 ±OUTPUT_LIMIT_FINE）
+ */
+int VbusComp_Apply(int fine);
+
+/**
+ * @brief 逆补偿：实际占空比换算回线性化后的占空比（输出限幅时回写积分用）
+ */
+int VbusComp_Remove(int fine);
+
+/**
+ * @brief 当前增益（Q16）
+ */
+uint32_t VbusComp_GetGain(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __VBUS_COMP_H */
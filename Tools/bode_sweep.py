@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""
+bode_sweep.py —— 速度环频率响应测量上位机工具
+
+1. 通过 USART2 写入频率表与扫频参数（MOTOR_CMD_BODE_FREQ / MOTOR_CMD_BODE_PARAM）
+2. 启动扫频（MOTOR_CMD_BODE），接收每个频点的增益与相位（片上已解调）
+3. 打印 Bode 表；loop 模式下插值给出穿越频率、相位裕度与增益裕度
+
+用法：
+    python bode_sweep.py --port COM5 --axis 0 --mode loop --amp 50
+    python bode_sweep.py --port COM5 --axis 1 --mode plant --amp 200 --offset 300 --freqs 1 2 5 10 20 50
+
+依赖：pyserial（Link 复用 sysid_fit.py，导入时需要 numpy）
+"""
+
+import argparse
+import math
+import sys
+import time
+
+from sysid_fit import Link  # 串口帧协议与应答解析
+
+CMD_BODE = 0xC0
+CMD_BODE_PARAM = 0xC1
+CMD_BODE_FREQ = 0xC2
+CMD_BODE_GAIN = 0xC3
+CMD_BODE_PHASE = 0xC4
+
+MODE = {"plant": 0, "loop": 1, "track": 2}
+PARAM = {"mode": 0, "amplitude": 1, "offset": 2, "settle_ms": 3, "measure_ms": 4}
+MAX_POINTS = 16
+
+
+def margins(points):
+    """points: [(f, |L|, ∠L°)]，返回 (穿越频率, 相位裕度, 增益裕度 dB)，缺项为 None"""
+    # 相位展开为连续曲线（固件上报值回绕在 ±180°）
+    unwrapped = []
+    for f, g, ph in points:
+        if unwrapped:
+            prev = unwrapped[-1][2]
+            ph -= 360.0 * round((ph - prev) / 360.0)
+        unwrapped.append((f, g, ph))
+
+    fc = pm = gm = None
+    for (f0, g0, p0), (f1, g1, p1) in zip(unwrapped, unwrapped[1:]):
+        if g0 <= 0 or g1 <= 0:
+            continue
+        l0, l1 = math.log10(f0), math.log10(f1)
+        d0, d1 = math.log10(g0), math.log10(g1)
+        if fc is None and d0 >= 0.0 > d1:
+            t = d0 / (d0 - d1)
+            fc = 10 ** (l0 + t * (l1 - l0))
+            pm = 180.0 + p0 + t * (p1 - p0)
+        if gm is None and p0 > -180.0 >= p1:
+            t = (p0 + 180.0) / (p0 - p1)
+            gm = -20.0 * (d0 + t * (d1 - d0))
+    return fc, pm, gm
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    p.add_argument("--port", required=True, help="串口")
+    p.add_argument("--axis", type=int, default=0)
+    p.add_argument("--mode", choices=list(MODE), default="loop")
+    p.add_argument("--amp", type=int, default=50, help="激励幅值（plant/loop：PWM；track：计数/ms）")
+    p.add_argument("--offset", type=int, default=300, help="plant 模式偏置占空比")
+    p.add_argument("--settle", type=int, default=200, help="ms")
+    p.add_argument("--measure", type=int, default=500, help="ms")
+    p.add_argument("--freqs", type=float, nargs="+", default=[1, 2, 5, 10, 20, 50, 100, 200], help="Hz")
+    args = p.parse_args()
+
+    if len(args.freqs) > MAX_POINTS:
+        p.error(f"at most {MAX_POINTS} frequencies")
+
+    link = Link(args.port)
+    settings = {"mode": MODE[args.mode], "amplitude": args.amp, "offset": args.offset,
+                "settle_ms": args.settle, "measure_ms": args.measure}
+    for name, value in settings.items():
+        link.send(CMD_BODE_PARAM, 0, PARAM[name], value)
+        time.sleep(0.01)
+    freqs = sorted(args.freqs)
+    for i, f in enumerate(freqs + [0]):
+        if i < MAX_POINTS:
+            link.send(CMD_BODE_FREQ, 0, i, int(round(f * 10)))
+            time.sleep(0.01)
+
+    link.send(CMD_BODE, args.axis, 0, 1)
+    # 每个频点至少 settle + measure，低频再加一个周期
+    timeout = max((args.settle + args.measure) / 1000.0 + 2.0 / f for f in freqs) + 1.0
+
+    gain, phase, count = {}, {}, None
+    for cmd, axis, idx, value in link.replies(timeout):
+        if cmd == CMD_BODE_GAIN:
+            gain[idx] = value / 65536.0
+        elif cmd == CMD_BODE_PHASE:
+            phase[idx] = value / 100.0
+        elif cmd == CMD_BODE and idx == 0:
+            count = value
+            break
+    if count is None:
+        sys.exit("no completion reply")
+
+    points = []
+    print(f"{'f (Hz)':>8} {'gain':>10} {'dB':>8} {'phase':>8}")
+    for i in range(count):
+        g, ph = gain.get(i), phase.get(i)
+        if g is None or ph is None:
+            print(f"{freqs[i]:8.1f}  (missing)")
+            continue
+        db = 20.0 * math.log10(g) if g > 0 else float("-inf")
+        print(f"{freqs[i]:8.1f} {g:10.4f} {db:8.2f} {ph:8.2f}")
+        points.append((freqs[i], g, ph))
+
+    if args.mode == "loop":
+        fc, pm, gm = margins(points)
+        print("crossover:", f"{fc:.1f} Hz, phase margin {pm:.1f} deg" if fc else "not found in range")
+        print("gain margin:", f"{gm:.1f} dB" if gm is not None else "not found in range")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""
+sysid_fit.py —— 系统辨识上位机工具
+
+1. 通过 USART2 配置并启动辨识（MOTOR_CMD_SYSID_PARAM / MOTOR_CMD_SYSID）
+2. 等待采集结束后上传数据（MOTOR_CMD_SYSID_DATA），保存为 CSV
+3. 最小二乘拟合一阶或二阶离散模型（ARX，含一个采样延迟和常数项），
+   换算为连续时间参数，并给出前馈 kV 与 PI 参数建议（与固件 ×100 单位一致）
+
+用法：
+    python sysid_fit.py --port COM5 --axis 0 --signal prbs --amp 200 --offset 300
+    python sysid_fit.py --port COM5 --axis 0 --signal chirp --f0 1 --f1 100 --loop closed
+    python sysid_fit.py --csv capture.csv --decim 1 --order 2
+
+依赖：numpy，pyserial（仅在线采集时需要）
+"""
+
+import argparse
+import csv
+import math
+import struct
+import sys
+import time
+
+import numpy as np
+
+BAUD = 115200
+TELEMETRY_LEN = 86          # '#' 遥测帧长度（见 uart2_dma_tx.c）
+REPLY_LEN = 10              # '$' 命令/应答帧长度
+
+CMD_SYSID = 0xB0
+CMD_SYSID_PARAM = 0xB1
+CMD_SYSID_DATA = 0xB2
+
+PARAM = {
+    "signal": 0, "closed": 1, "amplitude": 2, "offset": 3, "prbs_hold": 4,
+    "chirp_f0": 5, "chirp_f1": 6, "length": 7, "decim": 8,
+}
+
+
+# --------------------------------------------------------------------------
+# 串口协议
+# --------------------------------------------------------------------------
+def frame(cmd, axis, idx, value):
+    return struct.pack("<cBBHic", b"$", cmd, axis, idx, value, b"!")
+
+
+class Link:
+    def __init__(self, port):
+        import serial  # 仅在线采集时需要
+        self.ser = serial.Serial(port, BAUD, timeout=0.05)
+        self.buf = bytearray()
+
+    def send(self, cmd, axis, idx, value):
+        self.ser.write(frame(cmd, axis, idx, value))
+
+    def replies(self, timeout):
+        """按帧头/帧尾切分字节流，丢弃遥测帧，产出 (cmd, axis, idx, value)"""
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            self.buf += self.ser.read(512)
+            while self.buf:
+                head = self.buf[0]
+                if head == ord("$") and len(self.buf) >= REPLY_LEN:
+                    if self.buf[REPLY_LEN - 1] == ord("!"):
+                        _, cmd, axis, idx, value, _ = struct.unpack("<cBBHic", bytes(self.buf[:REPLY_LEN]))
+                        del self.buf[:REPLY_LEN]
+                        deadline = time.time() + timeout
+                        yield cmd, axis, idx, value
+                        continue
+                elif head == ord("#") and len(self.buf) >= TELEMETRY_LEN:
+                    if self.buf[TELEMETRY_LEN - 1] == ord("!"):
+                        del self.buf[:TELEMETRY_LEN]
+                        continue
+                elif head in (ord("$"), ord("#")):
+                    break  # 帧未收全
+                del self.buf[0]  # 失步，逐字节重新同步
+
+
+def capture(args):
+    link = Link(args.port)
+    settings = {
+        "signal": 0 if args.signal == "prbs" else 1,
+        "closed": 1 if args.loop == "closed" else 0,
+        "amplitude": args.amp,
+        "offset": args.offset,
+        "prbs_hold": args.hold,
+        "chirp_f0": int(round(args.f0 * 10)),
+        "chirp_f1": int(round(args.f1 * 10)),
+        "length": args.length,
+        "decim": args.decim,
+    }
+    for name, value in settings.items():
+        link.send(CMD_SYSID_PARAM, 0, PARAM[name], value)
+        time.sleep(0.01)
+
+    link.send(CMD_SYSID, args.axis, 0, 1)
+    duration = args.length * args.decim / 1000.0
+    print(f"capturing {args.length} samples ({duration:.1f} s)...")
+
+    count = None
+    for cmd, axis, idx, value in link.replies(duration + 2.0):
+        if cmd == CMD_SYSID and idx == 0:
+            count = value
+            break
+    if not count:
+        sys.exit("no completion reply")
+
+    link.send(CMD_SYSID, args.axis, 0, 2)
+    samples = {}
+    for cmd, axis, idx, value in link.replies(2.0):
+        if cmd == CMD_SYSID_DATA:
+            raw = value & 0xFFFFFFFF
+            duty = ((raw >> 16) ^ 0x8000) - 0x8000
+            delta = ((raw & 0xFFFF) ^ 0x8000) - 0x8000
+            samples[idx] = (duty / 8.0, delta)
+            if len(samples) == count:
+                break
+    if len(samples) != count:
+        print(f"warning: received {len(samples)}/{count} samples")
+
+    rows = [samples[k] for k in sorted(samples)]
+    with open(args.out, "w", newline="") as f:
+        w = csv.writer(f)
+        w.writerow(["duty", "delta"])
+        w.writerows(rows)
+    print(f"saved {args.out}")
+    return np.array(rows, dtype=float)
+
+
+def load_csv(path):
+    with open(path) as f:
+        r = csv.reader(f)
+        next(r)
+        return np.array([[float(a), float(b)] for a, b in r])
+
+
+# --------------------------------------------------------------------------
+# 模型拟合
+# --------------------------------------------------------------------------
+def fit(data, order, decim):
+    """
+    ARX（一个采样延迟，含常数项 c 吸收静摩擦/偏置）：
+      一阶：y[k] = a·y[k-1] + b·u[k-1] + c
+      二阶：y[k] = a1·y[k-1] + a2·y[k-2] + b1·u[k-1] + b2·u[k-2] + c
+    u 为占空比（0~1000），y 为速度（计数/ms）
+    """
+    u = data[:, 0]
+    y = data[:, 1] / decim
+    n = order
+    rows = []
+    for k in range(n, len(y)):
+        rows.append([y[k - i] for i in range(1, n + 1)] +
+                    [u[k - i] for i in range(1, n + 1)] + [1.0])
+    phi = np.array(rows)
+    theta, *_ = np.linalg.lstsq(phi, y[n:], rcond=None)
+    pred = phi @ theta
+    fit_pct = 100.0 * (1.0 - np.linalg.norm(y[n:] - pred) / np.linalg.norm(y[n:] - y[n:].mean()))
+    return theta, fit_pct
+
+
+def report(theta, order, decim, fit_pct, lam):
+    T = decim  # 采样周期（ms）
+    a = theta[:order]
+    b = theta[order:2 * order]
+    print(f"fit: {fit_pct:.1f}%  (order {order}, Ts = {T} ms)")
+    print("discrete: a =", np.round(a, 5), " b =", np.round(b, 6), f" c = {theta[-1]:.4f}")
+
+    gain = b.sum() / (1.0 - a.sum())          # 计数/ms 每单位占空比
+    print(f"DC gain K = {gain:.5f} (counts/ms)/PWM")
+    if gain <= 0:
+        print("non-positive gain, check wiring/sign")
+        return
+
+    if order == 1:
+        if not 0.0 < a[0] < 1.0:
+            print("pole outside (0,1), model not first-order")
+            return
+        tau = -T / math.log(a[0])
+        print(f"time constant tau = {tau:.1f} ms")
+    else:
+        poles = np.roots([1.0, -a[0], -a[1]])
+        taus = [-T / math.log(abs(p)) for p in poles if 0 < abs(p) < 1]
+        print("poles:", np.round(poles, 4), " time constants (ms):", np.round(taus, 1))
+        tau = max(taus) if taus else float("nan")
+
+    # 固件单位：kV、Kp 为 PWM/(计数/ms) ×100；Ki 为每 1ms 周期 ×100
+    kv = 100.0 / gain
+    lam = lam if lam else tau / 2.0
+    kp = tau / (gain * lam)
+    ki = kp / tau
+    print("suggested (lambda tuning, lambda = %.1f ms):" % lam)
+    print(f"  FF_KV  (0x10) = {kv:.0f}")
+    print(f"  PID_KP (0x13) = {kp * 100:.0f}")
+    print(f"  PID_KI (0x14) = {ki * 100:.0f}")
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    p.add_argument("--port", help="串口（在线采集）")
+    p.add_argument("--csv", help="离线拟合已保存的数据")
+    p.add_argument("--out", default="sysid.csv")
+    p.add_argument("--axis", type=int, default=0)
+    p.add_argument("--signal", choices=["prbs", "chirp"], default="prbs")
+    p.add_argument("--loop", choices=["open", "closed"], default="open")
+    p.add_argument("--amp", type=int, default=200)
+    p.add_argument("--offset", type=int, default=300)
+    p.add_argument("--hold", type=int, default=4)
+    p.add_argument("--f0", type=float, default=1.0, help="Hz")
+    p.add_argument("--f1", type=float, default=100.0, help="Hz")
+    p.add_argument("--length", type=int, default=2048)
+    p.add_argument("--decim", type=int, default=1)
+    p.add_argument("--order", type=int, choices=[1, 2], default=1)
+    p.add_argument("--lam", type=float, default=0.0, help="闭环时间常数 λ（ms），默认 τ/2")
+    args = p.parse_args()
+
+    if args.csv:
+        data = load_csv(args.csv)
+    elif args.port:
+        data = capture(args)
+    else:
+        p.error("--port or --csv required")
+
+    theta, fit_pct = fit(data, args.order, args.decim)
+    report(theta, args.order, args.decim, fit_pct, args.lam)
+
+
+if __name__ == "__main__":
+    main()